@@ -0,0 +1,27 @@
+#include "batch_planner.h"
+#include "counter_rng.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+std::vector<PlanResult> planBatch(const OccupancyGrid& grid, int canvasSize, const std::vector<BatchQuery>& queries,
+                                  const PlannerParams& params, uint64_t seed, int threads) {
+    std::vector<PlanResult> results(queries.size());
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = (int)std::min<size_t>(threads, queries.size());
+
+    // Queries are claimed one at a time since their run times vary widely
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        for (size_t q; (q = next.fetch_add(1)) < queries.size();) {
+            std::mt19937 rng = streamEngine(seed, queries[q].id);
+            results[q] = planRRTStar(grid, canvasSize, queries[q].start, queries[q].goal, params, rng);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(work);
+    work();
+    for (auto& t : pool) t.join();
+    return results;
+}
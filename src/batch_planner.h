@@ -0,0 +1,15 @@
+#pragma once
+
+#include "planner.h"
+
+// One query of a batch; id selects its random stream
+struct BatchQuery {
+    uint64_t id;
+    cv::Point2f start, goal;
+};
+
+// Plans every query with RRT* on worker threads (0 = hardware concurrency).
+// Each query draws from the counter-based stream (seed, id), so results are
+// identical for any thread count and scheduling order. Results are in input order.
+std::vector<PlanResult> planBatch(const OccupancyGrid& grid, int canvasSize, const std::vector<BatchQuery>& queries,
+                                  const PlannerParams& params, uint64_t seed, int threads = 0);
@@ -0,0 +1,111 @@
+#include "car_planner.h"
+#include <algorithm>
+
+// Checks poses along a curve every half cell
+static bool curveFree(const OccupancyGrid& grid, const Pose& from, const CurvePath& path, float rho, float upTo) {
+    float step = grid.cellSize * 0.5f;
+    int n = std::max(1, (int)std::ceil(upTo / step));
+    for (int i = 1; i <= n; ++i) {
+        Pose p = interpolate(from, path, rho, upTo * i / n);
+        if (isObstacle(grid, cv::Point2f(p.x, p.y))) return false;
+    }
+    return true;
+}
+
+CarPlanResult planCarRRTStar(const OccupancyGrid& grid, int canvasSize, const Pose& start, const cv::Point2f& goalPt,
+                             const PlannerParams& params, std::mt19937& rng, const PlannerHooks& hooks) {
+    CarPlanResult result;
+    std::vector<CarNode>& tree = result.tree;
+    tree.push_back({start, -1, 0});
+    const float rho = params.turningRadius;
+    const SteeringMode mode = params.steering == SteeringMode::Straight ? SteeringMode::Dubins : params.steering;
+
+    // Table covers every neighbour the rewiring radius can reach
+    const SteeringTable& table = cachedSteeringTable(mode, rho, std::max(params.stepSize, params.radiusScale) * 1.5f);
+
+    std::uniform_real_distribution<float> dis(0, canvasSize - 1.0f), heading(0, 6.2831853f);
+
+    for (int i = 0; i < params.maxIter; ++i) {
+        if (hooks.shouldStop && hooks.shouldStop()) break;
+
+        // Sample a position (goal-biased) and a heading
+        cv::Point2f randPt;
+        if (i % params.goalBiasPeriod == 0) randPt = goalPt;
+        else if (!params.narrowPassage || !sampleNarrowPassage(grid, params.sampler, rng, canvasSize, randPt))
+            randPt = cv::Point2f(dis(rng), dis(rng));
+        if (isObstacle(grid, randPt)) continue;
+        Pose sample = {randPt.x, randPt.y, heading(rng)};
+
+        // Nearest node by Euclidean distance, then steer along the curve
+        int nearest = 0;
+        float bestDist = 1e9f;
+        for (int j = 0; j < (int)tree.size(); ++j) {
+            float d = dist(cv::Point2f(tree[j].pose.x, tree[j].pose.y), randPt);
+            if (d < bestDist) bestDist = d, nearest = j;
+        }
+        CurvePath toSample = shortestPath(mode, tree[nearest].pose, sample, rho);
+        float travel = std::min(params.stepSize, toSample.length() * rho);
+        if (travel <= 0) continue;
+        Pose newPose = interpolate(tree[nearest].pose, toSample, rho, travel);
+        cv::Point2f newPt(newPose.x, newPose.y);
+
+        // The stored edge is the shortest curve to the new pose, which is what the path is rebuilt from
+        CurvePath direct = shortestPath(mode, tree[nearest].pose, newPose, rho);
+        if (!curveFree(grid, tree[nearest].pose, direct, rho, direct.length() * rho)) continue;
+
+        // Choose best parent: table lower bound first, exact curve only for possible winners
+        int bestParent = nearest;
+        float bestCost = tree[nearest].cost + direct.length() * rho;
+        float radius = params.radiusScale * std::sqrt(std::log(tree.size() + 1) / (tree.size() + 1));
+        for (int j = 0; j < (int)tree.size(); ++j) {
+            if (j == nearest || dist(cv::Point2f(tree[j].pose.x, tree[j].pose.y), newPt) >= radius) continue;
+            if (tree[j].cost + table.lowerBound(tree[j].pose, newPose) >= bestCost) continue;
+            CurvePath curve = shortestPath(mode, tree[j].pose, newPose, rho);
+            float cost = tree[j].cost + curve.length() * rho;
+            if (cost < bestCost && curveFree(grid, tree[j].pose, curve, rho, curve.length() * rho)) {
+                bestCost = cost;
+                bestParent = j;
+            }
+        }
+
+        int newIdx = tree.size();
+        tree.push_back({newPose, bestParent, bestCost});
+        if (hooks.onEdge) hooks.onEdge(cv::Point2f(tree[bestParent].pose.x, tree[bestParent].pose.y), newPt);
+
+        // Rewire nearby nodes through the new one
+        for (int j = 0; j < newIdx; ++j) {
+            if (dist(cv::Point2f(tree[j].pose.x, tree[j].pose.y), newPt) >= radius) continue;
+            if (bestCost + table.lowerBound(newPose, tree[j].pose) >= tree[j].cost) continue;
+            CurvePath curve = shortestPath(mode, newPose, tree[j].pose, rho);
+            float newCost = bestCost + curve.length() * rho;
+            if (newCost < tree[j].cost && curveFree(grid, newPose, curve, rho, curve.length() * rho)) {
+                tree[j].parent = newIdx;
+                tree[j].cost = newCost;
+            }
+        }
+
+        // Goal region reached at any heading
+        if (dist(newPt, goalPt) < grid.cellSize * 0.6f && (result.goalIdx == -1 || bestCost < tree[result.goalIdx].cost)) {
+            result.goalIdx = newIdx;
+            if (!params.anytime) break;
+        }
+
+        if (hooks.onIteration) hooks.onIteration(i);
+    }
+
+    // Expand tree edges into sampled curves
+    if (result.found()) {
+        std::vector<int> chain;
+        for (int cur = result.goalIdx; cur != -1; cur = tree[cur].parent) chain.push_back(cur);
+        std::reverse(chain.begin(), chain.end());
+        result.path.push_back(start);
+        std::vector<Pose> scratch;
+        for (size_t k = 1; k < chain.size(); ++k) {
+            const Pose& from = tree[chain[k - 1]].pose;
+            scratch.clear();
+            samplePath(from, shortestPath(mode, from, tree[chain[k]].pose, rho), rho, grid.cellSize * 0.5f, scratch);
+            result.path.insert(result.path.end(), scratch.begin() + 1, scratch.end());
+        }
+    }
+    return result;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "planner.h"
+
+// Tree node carrying a heading for car-like steering
+struct CarNode {
+    Pose pose;
+    int parent;
+    float cost;
+};
+
+struct CarPlanResult {
+    std::vector<CarNode> tree;
+    int goalIdx = -1;
+    std::vector<Pose> path;     // Poses sampled along the curves from start to goal
+
+    bool found() const { return goalIdx != -1; }
+};
+
+// RRT* with Dubins or Reeds-Shepp steering (params.steering). Choose-parent
+// and rewire rank candidates with a precomputed length table and only compute
+// exact curves (and check them against the grid) for candidates that can win.
+// The goal is reached at any heading. Costs are curve lengths: a cost map on
+// the grid is not integrated along curves and is ignored here.
+CarPlanResult planCarRRTStar(const OccupancyGrid& grid, int canvasSize, const Pose& start, const cv::Point2f& goalPt,
+                             const PlannerParams& params, std::mt19937& rng, const PlannerHooks& hooks = {});
@@ -0,0 +1,130 @@
+#include "compact_tree.h"
+#include "sample_buffer.h"
+#include <algorithm>
+
+uint32_t CompactTree::nearest(const cv::Point2f& pt) const {
+    // Integer distances in fixed-point units; 64-bit since two squared 16-bit deltas overflow 32 bits
+    uint32_t q = encode(pt);
+    int64_t qx = q & 0xFFFF, qy = q >> 16, bestD = INT64_MAX;
+    uint32_t best = 0;
+    for (size_t i = 0; i < xy_.size(); ++i) {
+        int64_t dx = (int64_t)(xy_[i] & 0xFFFF) - qx, dy = (int64_t)(xy_[i] >> 16) - qy;
+        int64_t d = dx * dx + dy * dy;
+        if (d < bestD) bestD = d, best = (uint32_t)i;
+    }
+    return best;
+}
+
+void CompactTree::near(const cv::Point2f& pt, float radius, std::vector<uint32_t>& out) const {
+    uint32_t q = encode(pt);
+    int64_t qx = q & 0xFFFF, qy = q >> 16;
+    double r = radius / scale_;
+    int64_t r2 = (int64_t)(r * r);
+    for (size_t i = 0; i < xy_.size(); ++i) {
+        int64_t dx = (int64_t)(xy_[i] & 0xFFFF) - qx, dy = (int64_t)(xy_[i] >> 16) - qy;
+        if (dx * dx + dy * dy < r2) out.push_back((uint32_t)i);
+    }
+}
+
+std::vector<cv::Point2f> CompactTree::pathTo(uint32_t node) const {
+    std::vector<cv::Point2f> path;
+    for (uint32_t cur = node; cur != NO_PARENT; cur = parent_[cur])
+        path.push_back(point(cur));
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+CompactPlanResult planCompactRRTStar(const OccupancyGrid& grid, int canvasSize, const cv::Point2f& startPt,
+                                     const cv::Point2f& goalPt, const PlannerParams& params, std::mt19937& rng,
+                                     const PlannerHooks& hooks) {
+    CompactPlanResult result((float)canvasSize);
+    CompactTree& tree = result.tree;
+    tree.reserve(params.maxIter + 1);
+    tree.add(tree.snap(startPt), CompactTree::NO_PARENT, 0);
+    SampleBuffer uniform(drawSeed(rng), 0, canvasSize - 1.0f);
+    std::vector<uint32_t> neighbors;
+
+    // The tree stores no lengths, so edgeValid gets them by walking the parent chain
+    auto lengthTo = [&](uint32_t node) {
+        float length = 0;
+        if (!hooks.edgeValid) return length;
+        for (uint32_t cur = node; tree.parent(cur) != CompactTree::NO_PARENT; cur = tree.parent(cur))
+            length += dist(tree.point(cur), tree.point(tree.parent(cur)));
+        return length;
+    };
+    auto edgeOk = [&](const cv::Point2f& from, float fromLength, const cv::Point2f& to, float toLength) {
+        if (!collisionFree(grid, from, to)) return false;
+        return !hooks.edgeValid || hooks.edgeValid(from, fromLength, to, toLength);
+    };
+
+    Corridor corridor;
+    if (params.hierarchical) {
+        corridor = findCorridor(grid, cv::Point(startPt.x / grid.cellSize, startPt.y / grid.cellSize),
+                                cv::Point(goalPt.x / grid.cellSize, goalPt.y / grid.cellSize), params.hier);
+        if (hooks.onCorridor) hooks.onCorridor(corridor);
+    }
+
+    for (int i = 0; i < params.maxIter; ++i) {
+        if (hooks.shouldStop && hooks.shouldStop()) break;
+
+        cv::Point2f randPt;
+        if (i % params.goalBiasPeriod == 0) {
+            randPt = goalPt;
+        } else if (!params.narrowPassage || !sampleNarrowPassage(grid, params.sampler, rng, canvasSize, randPt)) {
+            randPt = params.hierarchical ? sampleCorridor(corridor, params.hier, rng, canvasSize)
+                                         : uniform.next();
+        }
+        if (isObstacle(grid, randPt)) continue;
+
+        // Extend from the nearest node; the new point is snapped so it decodes exactly
+        uint32_t nearest = tree.nearest(randPt);
+        cv::Point2f nearPt = tree.point(nearest);
+        float d = dist(nearPt, randPt);
+        if (d == 0) continue;
+        cv::Point2f newPt = tree.snap(nearPt + (randPt - nearPt) * (std::min(params.stepSize, d) / d));
+        if (newPt == nearPt || isObstacle(grid, newPt)) continue;
+        float nearLength = lengthTo(nearest);
+        if (!edgeOk(nearPt, nearLength, newPt, nearLength + dist(nearPt, newPt))) continue;
+
+        // Choose best parent; edge cost is never below the length, which rules out most candidates cheaply
+        uint32_t bestParent = nearest;
+        float bestCost = tree.cost(nearest) + edgeCost(grid, nearPt, newPt);
+        float bestLength = nearLength + dist(nearPt, newPt);
+        float radius = params.radiusScale * std::sqrt(std::log(tree.size() + 1) / (tree.size() + 1));
+        neighbors.clear();
+        tree.near(newPt, radius, neighbors);
+        for (uint32_t j : neighbors) {
+            if (tree.cost(j) + dist(tree.point(j), newPt) >= bestCost) continue;
+            float cost = tree.cost(j) + edgeCost(grid, tree.point(j), newPt);
+            if (cost >= bestCost) continue;
+            float length = lengthTo(j), toLength = length + dist(tree.point(j), newPt);
+            if (edgeOk(tree.point(j), length, newPt, toLength)) bestCost = cost, bestLength = toLength, bestParent = j;
+        }
+
+        uint32_t newIdx = tree.add(newPt, bestParent, bestCost);
+        bestCost = tree.cost(newIdx);
+        if (hooks.onEdge) hooks.onEdge(tree.point(bestParent), newPt);
+
+        // Rewire
+        for (uint32_t j : neighbors) {
+            if (!tree.improves(j, bestCost + dist(newPt, tree.point(j)))) continue;
+            float newCost = bestCost + edgeCost(grid, newPt, tree.point(j));
+            if (tree.improves(j, newCost) && edgeOk(newPt, bestLength, tree.point(j), bestLength + dist(newPt, tree.point(j))))
+                tree.setParent(j, newIdx, newCost);
+        }
+
+        if (dist(newPt, goalPt) < grid.cellSize * 0.6f && (!result.found() || bestCost < tree.cost(result.goalIdx))) {
+            result.goalIdx = newIdx;
+            if (hooks.onSolution) hooks.onSolution(tree.pathTo(newIdx), bestCost);
+            if (!params.anytime) break;
+        }
+
+        if (hooks.onIteration) hooks.onIteration(i);
+    }
+
+    if (result.found()) {
+        result.path = tree.pathTo(result.goalIdx);
+        result.smoothed = smoothPath(grid, result.path, params);
+    }
+    return result;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "planner.h"
+#include <cstring>
+
+// Structure-of-arrays RRT* tree for very large node counts: 10 bytes per node
+// (versus 16 for Node). Coordinates are 16-bit fixed point over the canvas,
+// packed into one word so nearest/rewire scans stream 4 bytes per node.
+// Points must be snapped before insertion, which makes decoding exact.
+// Costs are 16-bit floats (11 mantissa bits over [2^-4, 2^27)) rounded up,
+// so a node never looks cheaper than its parent and rewiring cannot loop.
+class CompactTree {
+public:
+    static const uint32_t NO_PARENT = 0xFFFFFFFFu;
+
+    explicit CompactTree(float extent) : scale_(extent / 65535.0f) {}
+
+    void reserve(size_t n) { xy_.reserve(n); parent_.reserve(n); cost_.reserve(n); }
+
+    // Nearest representable position
+    cv::Point2f snap(const cv::Point2f& pt) const { return decode(encode(pt)); }
+
+    uint32_t add(const cv::Point2f& pt, uint32_t parent, float cost) {
+        xy_.push_back(encode(pt));
+        parent_.push_back(parent);
+        cost_.push_back(packCost(cost));
+        return (uint32_t)xy_.size() - 1;
+    }
+
+    size_t size() const { return xy_.size(); }
+    size_t bytes() const { return xy_.capacity() * 4 + parent_.capacity() * 4 + cost_.capacity() * 2; }
+
+    cv::Point2f point(uint32_t i) const { return decode(xy_[i]); }
+    uint32_t parent(uint32_t i) const { return parent_[i]; }
+    float cost(uint32_t i) const { return unpackCost(cost_[i]); }
+    void setParent(uint32_t i, uint32_t parent, float cost) { parent_[i] = parent; cost_[i] = packCost(cost); }
+
+    // True if cost is still cheaper than node i's once packed
+    bool improves(uint32_t i, float cost) const { return packCost(cost) < cost_[i]; }
+
+    // Index of the nearest node (tree must not be empty)
+    uint32_t nearest(const cv::Point2f& pt) const;
+
+    // Indices of all nodes strictly within radius pixels, appended to out
+    void near(const cv::Point2f& pt, float radius, std::vector<uint32_t>& out) const;
+
+    // Decoded start-to-node path
+    std::vector<cv::Point2f> pathTo(uint32_t node) const;
+
+private:
+    uint32_t encode(const cv::Point2f& pt) const {
+        auto q = [&](float v) { return (uint32_t)std::clamp(std::lround(v / scale_), 0L, 65535L); };
+        return q(pt.x) | (q(pt.y) << 16);
+    }
+    cv::Point2f decode(uint32_t v) const { return cv::Point2f((v & 0xFFFF) * scale_, (v >> 16) * scale_); }
+
+    static const uint32_t COST_BASE = 123u << 23;  // Float bits of 2^-4; 0 is kept for a zero cost
+    static uint16_t packCost(float cost) {
+        if (!(cost > 0)) return 0;
+        uint32_t bits;
+        std::memcpy(&bits, &cost, 4);
+        if (bits <= COST_BASE) return 1;
+        return (uint16_t)std::min<uint32_t>(1 + ((bits - COST_BASE + 0xFFF) >> 12), 0xFFFF);
+    }
+    static float unpackCost(uint16_t packed) {
+        if (packed == 0) return 0;
+        uint32_t bits = ((uint32_t)(packed - 1) << 12) + COST_BASE;
+        float cost;
+        std::memcpy(&cost, &bits, 4);
+        return cost;
+    }
+
+    float scale_;                   // Pixels per fixed-point step
+    std::vector<uint32_t> xy_;      // x | y << 16
+    std::vector<uint32_t> parent_;
+    std::vector<uint16_t> cost_;
+};
+
+struct CompactPlanResult {
+    CompactTree tree;
+    uint32_t goalIdx = CompactTree::NO_PARENT;
+    std::vector<cv::Point2f> path, smoothed;
+
+    explicit CompactPlanResult(float extent) : tree(extent) {}
+    bool found() const { return goalIdx != CompactTree::NO_PARENT; }
+};
+
+// planRRTStar() on a CompactTree; same sampling, parameters and hooks, except
+// that nodeBudget is not supported (the tree has no child counts to evict by).
+// Nodes store no path lengths, so with edgeValid set each check walks the
+// parent chain to compute them.
+CompactPlanResult planCompactRRTStar(const OccupancyGrid& grid, int canvasSize, const cv::Point2f& startPt,
+                                     const cv::Point2f& goalPt, const PlannerParams& params, std::mt19937& rng,
+                                     const PlannerHooks& hooks = {});
@@ -0,0 +1,66 @@
+#include "cost_map.h"
+#include "occupancy_grid.h"
+#include <algorithm>
+
+void CostMap::build(int rows, int cols, int cellSize, const std::vector<uint8_t>& levels) {
+    rows_ = rows;
+    cols_ = cols;
+    cellSize_ = cellSize;
+    levels_ = levels;
+    levels_.resize((size_t)rows * cols, 0);
+    for (int l = 0; l < 256; ++l) factors_[l] = factor((uint8_t)l);
+
+    blockCols_ = (cols + BLOCK - 1) / BLOCK;
+    int blockRows = (rows + BLOCK - 1) / BLOCK;
+    blockMin_.assign((size_t)blockRows * blockCols_, 0);
+    blockMax_.assign((size_t)blockRows * blockCols_, 0);
+    for (int br = 0; br < blockRows; ++br)
+        for (int bc = 0; bc < blockCols_; ++bc) updateBlock(br, bc);
+}
+
+void CostMap::updateBlock(int br, int bc) {
+    uint8_t lo = 255, hi = 0;
+    for (int r = br * BLOCK; r < std::min(rows_, (br + 1) * BLOCK); ++r)
+        for (int c = bc * BLOCK; c < std::min(cols_, (bc + 1) * BLOCK); ++c)
+            lo = std::min(lo, levels_[r * cols_ + c]), hi = std::max(hi, levels_[r * cols_ + c]);
+    blockMin_[br * blockCols_ + bc] = lo;
+    blockMax_[br * blockCols_ + bc] = hi;
+}
+
+float CostMap::edgeCost(const cv::Point2f& a, const cv::Point2f& b) const {
+    float len = cv::norm(b - a);
+    if (levels_.empty() || len == 0) return len;
+
+    // Fast path: every block under the edge's bounding box has one and the same level
+    int r0 = (int)std::floor(std::min(a.y, b.y) / cellSize_), r1 = (int)std::floor(std::max(a.y, b.y) / cellSize_);
+    int c0 = (int)std::floor(std::min(a.x, b.x) / cellSize_), c1 = (int)std::floor(std::max(a.x, b.x) / cellSize_);
+    if (r0 >= 0 && c0 >= 0 && r1 < rows_ && c1 < cols_) {
+        uint8_t level = blockMin_[(r0 / BLOCK) * blockCols_ + c0 / BLOCK];
+        bool uniform = true;
+        for (int br = r0 / BLOCK; br <= r1 / BLOCK && uniform; ++br)
+            for (int bc = c0 / BLOCK; bc <= c1 / BLOCK && uniform; ++bc)
+                uniform = blockMin_[br * blockCols_ + bc] == level && blockMax_[br * blockCols_ + bc] == level;
+        if (uniform) return len * factors_[level];
+    }
+
+    // Exact integration: fraction of the edge spent in each cell times its factor,
+    // gathered into small batches so the weighted sum runs as a vector loop
+    const int BATCH = 32;
+    float spans[BATCH], weights[BATCH];
+    int n = 0;
+    float total = 0;
+    auto flush = [&]() {
+        float sum = 0;
+        for (int k = 0; k < n; ++k) sum += spans[k] * weights[k];
+        total += sum;
+        n = 0;
+    };
+    traverseCells(cellSize_, a, b, [&](int r, int c, float t0, float t1) {
+        spans[n] = t1 - t0;
+        weights[n] = (r >= 0 && r < rows_ && c >= 0 && c < cols_) ? factors_[levels_[r * cols_ + c]] : 1.0f;
+        if (++n == BATCH) flush();
+        return true;
+    });
+    flush();
+    return total * len;
+}
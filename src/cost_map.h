@@ -0,0 +1,31 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <vector>
+
+// Soft per-cell traversal costs, one byte per cell: a cell at level L costs
+// 1 + L / 16 per pixel travelled, so level 0 is plain distance. Min/max
+// levels of 8x8 blocks let edges through uniform regions skip the traversal.
+class CostMap {
+public:
+    static const int BLOCK = 8;
+
+    void build(int rows, int cols, int cellSize, const std::vector<uint8_t>& levels);
+
+    bool empty() const { return levels_.empty(); }
+    uint8_t level(int r, int c) const { return levels_[r * cols_ + c]; }
+    size_t bytes() const { return levels_.capacity() + blockMin_.capacity() + blockMax_.capacity(); }
+    static float factor(uint8_t level) { return 1.0f + level / 16.0f; }
+
+    // Length of a-b weighted by the factor of every cell it crosses; cells outside the map cost 1
+    float edgeCost(const cv::Point2f& a, const cv::Point2f& b) const;
+
+private:
+    void updateBlock(int br, int bc);
+
+    int rows_ = 0, cols_ = 0, cellSize_ = 1, blockCols_ = 0;
+    std::vector<uint8_t> levels_;
+    std::vector<uint8_t> blockMin_, blockMax_;
+    float factors_[256];
+};
@@ -0,0 +1,26 @@
+#include "counter_rng.h"
+
+std::array<uint32_t, 4> philox4x32(std::array<uint32_t, 4> ctr, std::array<uint32_t, 2> key) {
+    const uint32_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+    const uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+    for (int round = 0; round < 10; ++round) {
+        uint64_t p0 = (uint64_t)M0 * ctr[0], p1 = (uint64_t)M1 * ctr[2];
+        ctr = {(uint32_t)(p1 >> 32) ^ ctr[1] ^ key[0], (uint32_t)p1, (uint32_t)(p0 >> 32) ^ ctr[3] ^ key[1], (uint32_t)p0};
+        key[0] += W0;
+        key[1] += W1;
+    }
+    return ctr;
+}
+
+float CounterRng::uniformAt(uint64_t index) const {
+    uint64_t block = index / 4;
+    auto words = philox4x32({(uint32_t)block, (uint32_t)(block >> 32), (uint32_t)stream_, (uint32_t)(stream_ >> 32)},
+                            {(uint32_t)seed_, (uint32_t)(seed_ >> 32)});
+    return (words[index % 4] >> 8) * (1.0f / 16777216.0f);
+}
+
+std::mt19937 streamEngine(uint64_t seed, uint64_t stream) {
+    CounterRng words(seed, stream);
+    std::seed_seq seq{words(), words(), words(), words(), words(), words(), words(), words()};
+    return std::mt19937(seq);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+// Philox4x32-10 block: a keyed bijection of a 128-bit counter
+std::array<uint32_t, 4> philox4x32(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key);
+
+// Counter-based random stream addressed by (seed, stream, index). Word i of a
+// stream is a pure function of those three values, so work split across any
+// number of threads, in any order, sees the same numbers as a serial run.
+// Satisfies UniformRandomBitGenerator.
+class CounterRng {
+public:
+    using result_type = uint32_t;
+
+    CounterRng(uint64_t seed, uint64_t stream, uint64_t index = 0) : seed_(seed), stream_(stream) { seek(index); }
+
+    // Position the stream at word index
+    void seek(uint64_t index) {
+        block_ = index / 4;
+        lane_ = index % 4;
+        fill();
+    }
+
+    uint32_t operator()() {
+        if (lane_ == 4) {
+            ++block_;
+            lane_ = 0;
+            fill();
+        }
+        return words_[lane_++];
+    }
+
+    // Uniform float in [0, 1) from word index, without touching the stream position
+    float uniformAt(uint64_t index) const;
+
+    static constexpr uint32_t min() { return 0; }
+    static constexpr uint32_t max() { return std::numeric_limits<uint32_t>::max(); }
+
+private:
+    void fill() {
+        words_ = philox4x32({(uint32_t)block_, (uint32_t)(block_ >> 32), (uint32_t)stream_, (uint32_t)(stream_ >> 32)},
+                            {(uint32_t)seed_, (uint32_t)(seed_ >> 32)});
+    }
+
+    uint64_t seed_, stream_, block_ = 0;
+    int lane_ = 0;
+    std::array<uint32_t, 4> words_;
+};
+
+// Standard engine for planners taking std::mt19937, seeded from stream (seed, stream)
+std::mt19937 streamEngine(uint64_t seed, uint64_t stream);
@@ -0,0 +1,171 @@
+#include "distance_field.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// 1D squared distance transform of f (Felzenszwalb-Huttenlocher lower envelope of parabolas)
+static void transform1d(const float* f, float* d, int n, std::vector<int>& v, std::vector<float>& z) {
+    const float inf = std::numeric_limits<float>::infinity();
+    int k = 0;
+    v[0] = 0;
+    z[0] = -inf;
+    z[1] = inf;
+    for (int q = 1; q < n; ++q) {
+        if (f[q] == inf) continue;
+        if (f[v[0]] == inf) {
+            v[0] = q;
+            continue;
+        }
+        float s;
+        for (;;) {
+            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+            if (s > z[k] || k == 0) break;
+            --k;
+        }
+        if (s <= z[k]) {
+            v[0] = q;       // k == 0 and q dominates everywhere
+            z[1] = inf;
+            continue;
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = inf;
+    }
+    k = 0;
+    for (int q = 0; q < n; ++q) {
+        while (z[k + 1] < q) ++k;
+        d[q] = f[v[k]] == inf ? inf : (q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+}
+
+// Cells a polygon overlaps: the polygon crosses a cell edge, covers the centre, or lies inside the cell
+static std::vector<uint8_t> polygonCells(const OccupancyGrid& grid) {
+    std::vector<uint8_t> hit((size_t)grid.rows * grid.cols, 0);
+    float s = (float)grid.cellSize;
+    for (const Polygon& poly : grid.polygons->polygons())
+        for (const cv::Point2f& p : poly) {
+            int r = (int)std::floor(p.y / s), c = (int)std::floor(p.x / s);
+            if (grid.inside(r, c)) hit[r * grid.cols + c] = 1;
+        }
+    for (int r = 0; r < grid.rows; ++r)
+        for (int c = 0; c < grid.cols; ++c) {
+            if (hit[r * grid.cols + c]) continue;
+            cv::Point2f tl(c * s, r * s), tr((c + 1) * s, r * s), bl(c * s, (r + 1) * s), br((c + 1) * s, (r + 1) * s);
+            hit[r * grid.cols + c] = grid.polygons->contains((tl + br) * 0.5f) || grid.polygons->intersects(tl, tr) ||
+                                     grid.polygons->intersects(tr, br) || grid.polygons->intersects(br, bl) ||
+                                     grid.polygons->intersects(bl, tl);
+        }
+    return hit;
+}
+
+void DistanceField::build(const OccupancyGrid& grid) {
+    // Pad with a ring of occupied cells so the border repels like an obstacle
+    rows_ = grid.rows;
+    cols_ = grid.cols;
+    cellSize_ = grid.cellSize;
+    int pr = rows_ + 2, pc = cols_ + 2, n = std::max(pr, pc);
+    const float inf = std::numeric_limits<float>::infinity();
+    std::vector<float> sq((size_t)pr * pc), line(n), out(n), z(n + 1);
+    std::vector<int> v(n);
+    std::vector<uint8_t> polys = grid.polygons ? polygonCells(grid) : std::vector<uint8_t>();
+    for (int r = 0; r < pr; ++r)
+        for (int c = 0; c < pc; ++c) {
+            bool poly = !polys.empty() && grid.inside(r - 1, c - 1) && polys[(r - 1) * cols_ + c - 1];
+            sq[r * pc + c] = grid.occupied(r - 1, c - 1) || poly ? 0.0f : inf;
+        }
+
+    for (int c = 0; c < pc; ++c) {
+        for (int r = 0; r < pr; ++r) line[r] = sq[r * pc + c];
+        transform1d(line.data(), out.data(), pr, v, z);
+        for (int r = 0; r < pr; ++r) sq[r * pc + c] = out[r];
+    }
+    for (int r = 0; r < pr; ++r) {
+        transform1d(&sq[r * pc], out.data(), pc, v, z);
+        std::copy(out.begin(), out.begin() + pc, sq.begin() + r * pc);
+    }
+
+    // Centre-to-centre distance minus half a cell approximates the distance to the obstacle's edge
+    dist_.resize((size_t)rows_ * cols_);
+    for (int r = 0; r < rows_; ++r)
+        for (int c = 0; c < cols_; ++c)
+            dist_[r * cols_ + c] = std::max(0.0f, std::sqrt(sq[(r + 1) * pc + c + 1]) - 0.5f) * cellSize_;
+}
+
+float DistanceField::at(const cv::Point2f& pt) const {
+    float x = pt.x / cellSize_ - 0.5f, y = pt.y / cellSize_ - 0.5f;
+    x = std::clamp(x, 0.0f, cols_ - 1.0f);
+    y = std::clamp(y, 0.0f, rows_ - 1.0f);
+    int c = std::min((int)x, std::max(cols_ - 2, 0)), r = std::min((int)y, std::max(rows_ - 2, 0));
+    int c1 = std::min(c + 1, cols_ - 1), r1 = std::min(r + 1, rows_ - 1);
+    float fx = x - c, fy = y - r;
+    float top = dist_[r * cols_ + c] * (1 - fx) + dist_[r * cols_ + c1] * fx;
+    float bottom = dist_[r1 * cols_ + c] * (1 - fx) + dist_[r1 * cols_ + c1] * fx;
+    return top * (1 - fy) + bottom * fy;
+}
+
+cv::Point2f DistanceField::gradient(const cv::Point2f& pt) const {
+    float h = cellSize_ * 0.5f;
+    cv::Point2f g((at(pt + cv::Point2f(h, 0)) - at(pt - cv::Point2f(h, 0))) / (2 * h),
+                  (at(pt + cv::Point2f(0, h)) - at(pt - cv::Point2f(0, h))) / (2 * h));
+    float len = cv::norm(g);
+    return len > 1e-6f ? g * (1.0f / len) : cv::Point2f(0, 0);
+}
+
+// Clearance changes by at most one pixel per pixel moved (up to interpolation
+// error), so endpoints whose clearances sum well past the length bound the
+// whole segment away from obstacles; otherwise fall back to the grid's check
+bool ClearanceSmoother::segmentFree(const cv::Point2f& a, float clearA, const cv::Point2f& b, float clearB) const {
+    float len = cv::norm(b - a);
+    if (clearA + clearB > 1.5f * len + grid_.cellSize) return true;
+    return collisionFree(grid_, a, b);
+}
+
+void ClearanceSmoother::smooth(const std::vector<cv::Point2f>& path, std::vector<cv::Point2f>& out) {
+    out = path;
+    if (path.size() < 2 || field_.empty()) return;
+
+    // Resample so interior points can bend the path
+    points_.clear();
+    for (size_t i = 1; i < path.size(); ++i) {
+        int pieces = std::max(1, (int)std::ceil(cv::norm(path[i] - path[i - 1]) / cfg_.spacing));
+        for (int k = 0; k < pieces; ++k) points_.push_back(path[i - 1] + (path[i] - path[i - 1]) * ((float)k / pieces));
+    }
+    points_.push_back(path.back());
+    size_t n = points_.size();
+    clear_.resize(n);
+    for (size_t i = 0; i < n; ++i) clear_[i] = field_.at(points_[i]);
+
+    // Gauss-Seidel sweeps with endpoints fixed; a move that would make a
+    // neighbouring segment unsafe is skipped for this sweep
+    for (int it = 0; it < cfg_.iterations; ++it) {
+        for (size_t i = 1; i + 1 < n; ++i) {
+            cv::Point2f p = points_[i];
+            cv::Point2f step = ((points_[i - 1] + points_[i + 1]) * 0.5f - p) * cfg_.smoothWeight;
+            if (clear_[i] < cfg_.clearance)
+                step += field_.gradient(p) * ((cfg_.clearance - clear_[i]) * cfg_.clearanceWeight);
+            if (step.x == 0 && step.y == 0) continue;
+
+            cv::Point2f q = p + step;
+            float clearQ = field_.at(q);
+            if (isObstacle(grid_, q) || !segmentFree(points_[i - 1], clear_[i - 1], q, clearQ) ||
+                !segmentFree(q, clearQ, points_[i + 1], clear_[i + 1]))
+                continue;
+            points_[i] = q;
+            clear_[i] = clearQ;
+        }
+    }
+
+    // Keep the result only if every segment passes the same check as the planner's edges
+    // and, with a cost map, the extra clearance did not make the path costlier
+    float inCost = 0, outCost = 0;
+    for (size_t i = 1; i < n; ++i) {
+        if (!collisionFree(grid_, points_[i - 1], points_[i])) return;
+        if (grid_.costs) outCost += edgeCost(grid_, points_[i - 1], points_[i]);
+    }
+    if (grid_.costs) {
+        for (size_t i = 1; i < path.size(); ++i) inCost += edgeCost(grid_, path[i - 1], path[i]);
+        if (outCost > inCost) return;
+    }
+    out.assign(points_.begin(), points_.end());
+}
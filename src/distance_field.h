@@ -0,0 +1,50 @@
+#pragma once
+
+#include "occupancy_grid.h"
+#include <vector>
+
+// Euclidean clearance in pixels from each cell centre to the nearest obstacle
+// cell (or the grid border), looked up with bilinear interpolation. Cells that
+// a polygon overlaps count as obstacle cells.
+class DistanceField {
+public:
+    void build(const OccupancyGrid& grid);
+    bool empty() const { return dist_.empty(); }
+
+    float at(const cv::Point2f& pt) const;
+    cv::Point2f gradient(const cv::Point2f& pt) const;    // Points away from obstacles
+
+private:
+    int rows_ = 0, cols_ = 0, cellSize_ = 1;
+    std::vector<float> dist_;
+};
+
+struct ClearanceConfig {
+    int iterations = 40;            // Fixed optimization budget
+    float clearance = 20.0f;        // Pixels beyond which obstacles stop pushing
+    float spacing = 8.0f;           // Points are resampled to at most this far apart
+    float smoothWeight = 0.4f;      // Pull towards the neighbours' midpoint (shortens and straightens)
+    float clearanceWeight = 0.3f;   // Push down the distance gradient when closer than clearance
+};
+
+// Optimizes a collision-free polyline for length plus clearance. Buffers are
+// kept between calls, so a smoother reused across queries does not allocate
+// once they have grown to the longest path seen.
+class ClearanceSmoother {
+public:
+    ClearanceSmoother(const OccupancyGrid& grid, const DistanceField& field, const ClearanceConfig& cfg = {})
+        : grid_(grid), field_(field), cfg_(cfg) {}
+
+    // Writes the optimized path to out; out is the input unchanged if the
+    // result could not be kept collision-free or costs more than the input
+    void smooth(const std::vector<cv::Point2f>& path, std::vector<cv::Point2f>& out);
+
+private:
+    bool segmentFree(const cv::Point2f& a, float clearA, const cv::Point2f& b, float clearB) const;
+
+    const OccupancyGrid& grid_;
+    const DistanceField& field_;
+    ClearanceConfig cfg_;
+    std::vector<cv::Point2f> points_;
+    std::vector<float> clear_;      // Clearance of each point, refreshed as it moves
+};
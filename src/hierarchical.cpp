@@ -0,0 +1,87 @@
+#include "hierarchical.h"
+#include <algorithm>
+#include <queue>
+
+// 4-connected A* on a coarse grid; returns the cell sequence or an empty vector
+static std::vector<cv::Point> coarseSearch(const OccupancyGrid& coarse, cv::Point s, cv::Point g) {
+    const int n = coarse.rows * coarse.cols;
+    std::vector<int> gScore(n, INT32_MAX), parent(n, -1);
+    using Entry = std::pair<int, int>;   // (f-score, cell index)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+    // The start and goal cells are searched even if pooling marked them occupied
+    auto blocked = [&](int r, int c) {
+        if (!coarse.inside(r, c)) return true;
+        if ((r == s.y && c == s.x) || (r == g.y && c == g.x)) return false;
+        return coarse.occupied(r, c);
+    };
+    auto heuristic = [&](int r, int c) { return std::abs(r - g.y) + std::abs(c - g.x); };
+
+    int startIdx = s.y * coarse.cols + s.x, goalIdx = g.y * coarse.cols + g.x;
+    gScore[startIdx] = 0;
+    open.push({heuristic(s.y, s.x), startIdx});
+
+    const int dr[4] = {-1, 1, 0, 0}, dc[4] = {0, 0, -1, 1};
+    while (!open.empty()) {
+        auto [f, cur] = open.top(); open.pop();
+        int r = cur / coarse.cols, c = cur % coarse.cols;
+        if (f - heuristic(r, c) > gScore[cur]) continue;   // Stale entry
+        if (cur == goalIdx) break;
+
+        for (int k = 0; k < 4; ++k) {
+            int nr = r + dr[k], nc = c + dc[k];
+            if (blocked(nr, nc)) continue;
+            int next = nr * coarse.cols + nc;
+            if (gScore[cur] + 1 < gScore[next]) {
+                gScore[next] = gScore[cur] + 1;
+                parent[next] = cur;
+                open.push({gScore[next] + heuristic(nr, nc), next});
+            }
+        }
+    }
+
+    std::vector<cv::Point> path;
+    if (gScore[goalIdx] == INT32_MAX) return path;
+    for (int cur = goalIdx; cur != -1; cur = parent[cur])
+        path.push_back(cv::Point(cur % coarse.cols, cur / coarse.cols));
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+Corridor findCorridor(const OccupancyGrid& grid, cv::Point startCell, cv::Point goalCell, const HierarchicalConfig& cfg) {
+    Corridor corridor;
+    for (int factor = std::max(1, cfg.coarseFactor); factor >= 1; factor /= 2) {
+        OccupancyGrid coarse = factor == 1 ? grid : maxPool(grid, factor);
+        cv::Point s(startCell.x / factor, startCell.y / factor), g(goalCell.x / factor, goalCell.y / factor);
+        std::vector<cv::Point> path = coarseSearch(coarse, s, g);
+        if (path.empty()) continue;
+
+        // Widen the coarse path so RRT* has room to round corners
+        std::vector<uint8_t> inCorridor((size_t)coarse.rows * coarse.cols, 0);
+        for (auto& p : path) {
+            for (int dy = -cfg.dilation; dy <= cfg.dilation; ++dy) {
+                for (int dx = -cfg.dilation; dx <= cfg.dilation; ++dx) {
+                    int r = p.y + dy, c = p.x + dx;
+                    if (!coarse.inside(r, c) || inCorridor[r * coarse.cols + c]) continue;
+                    inCorridor[r * coarse.cols + c] = 1;
+                    corridor.cells.push_back(cv::Point(c, r));
+                }
+            }
+        }
+        corridor.cellPx = coarse.cellSize;
+        break;
+    }
+    return corridor;
+}
+
+cv::Point2f sampleCorridor(const Corridor& corridor, const HierarchicalConfig& cfg, std::mt19937& rng, int canvasSize) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    if (corridor.empty() || unit(rng) < cfg.globalRatio)
+        return cv::Point2f(unit(rng) * canvasSize, unit(rng) * canvasSize);
+
+    std::uniform_int_distribution<size_t> pick(0, corridor.cells.size() - 1);
+    const cv::Point& cell = corridor.cells[pick(rng)];
+    float x = (cell.x + unit(rng)) * corridor.cellPx;
+    float y = (cell.y + unit(rng)) * corridor.cellPx;
+    return cv::Point2f(std::min(x, canvasSize - 1.0f), std::min(y, canvasSize - 1.0f));
+}
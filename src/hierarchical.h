@@ -0,0 +1,28 @@
+#pragma once
+
+#include "occupancy_grid.h"
+#include <random>
+
+// Settings for coarse-to-fine planning
+struct HierarchicalConfig {
+    int coarseFactor = 4;       // Fine cells per coarse cell along each axis
+    int dilation = 1;           // Corridor widening (in coarse cells) around the coarse path
+    float globalRatio = 0.1f;   // Fraction of samples still drawn from the whole canvas
+};
+
+// Set of coarse cells that RRT* sampling is restricted to
+struct Corridor {
+    int cellPx = 0;                 // Size of one corridor cell in pixels
+    std::vector<cv::Point> cells;   // Corridor cells in coarse coordinates (x = col, y = row)
+
+    bool empty() const { return cells.empty(); }
+};
+
+// Grid search between two fine cells on a max-pooled copy of the grid.
+// The factor is halved until a coarse path exists; an empty corridor means
+// no path was found even at full resolution.
+Corridor findCorridor(const OccupancyGrid& grid, cv::Point startCell, cv::Point goalCell, const HierarchicalConfig& cfg);
+
+// Sample a pixel position inside the corridor, or anywhere on the canvas
+// with probability cfg.globalRatio (always, if the corridor is empty)
+cv::Point2f sampleCorridor(const Corridor& corridor, const HierarchicalConfig& cfg, std::mt19937& rng, int canvasSize);
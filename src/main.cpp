@@ -6,13 +6,14 @@
 #include <algorithm>
 #include <random>
 #include <cmath>
-
-// Node structure for RRT* tree
-struct Node {
-    cv::Point2f point;  
-    int parent;        
-    float cost;         
-};
+#include <cstring>
+#include "map_io.h"
+#include "car_planner.h"
+#include "compact_tree.h"
+#include "multi_agent.h"
+#include "plan_executor.h"
+#include "profile.h"
+#include "visibility_graph.h"
 
 // Global variables
 int gridSize = 5;                                       // Size of the grid (gridSize x gridSize)
@@ -20,16 +21,21 @@ const int canvasSize = 500;                             // Size of the drawing c
 int cellSize;                                           // Size of one cell in pixels (computed from gridSize)
 cv::Point start(-1, -1), goal(-1, -1);                  // Start and goal positions in grid coordinates
 std::set<std::pair<int, int>> obstacles;                // Set of obstacle cell coordinates
+MapOverlays overlays;                                   // Polygon obstacles and soft costs from the map file
 std::stack<std::pair<int, int>> undoStack, redoStack;   // Undo/redo stacks for obstacle placement
 cv::Mat gridImg;                                        // Image for grid display
 bool selectingStart = true, configured = false;         // GUI interaction flags
-
-// Clamp point within canvas bounds
-cv::Point2f clampToGrid(const cv::Point2f& pt) {
-    float x = std::clamp(pt.x, 0.0f, (float)(canvasSize - 1));
-    float y = std::clamp(pt.y, 0.0f, (float)(canvasSize - 1));
-    return cv::Point2f(x, y);
-}
+bool hierarchical = false;                              // Restrict sampling to a coarse corridor
+bool narrowPassage = false;                             // Mix in bridge-test and Gaussian samples
+bool clearanceSmoothing = false;                        // Push the final path away from obstacles
+SteeringMode steering = SteeringMode::Straight;         // Straight-line or car-like edges
+bool visibilityMode = false;                            // Exact shortest path over obstacle corners instead of RRT*
+std::vector<std::pair<cv::Point, cv::Point>> agents;    // Committed (start, goal) pairs for multi-agent planning
+bool livePlanning = true;                               // Replan in the background while editing
+bool mapDirty = true;                                   // Map or start/goal changed since the live plan started
+PlanExecutor liveExecutor(100);                         // Runs the live plan in slices between UI events
+std::shared_ptr<PlanTask> liveTask;                     // Current live plan, cancelled on every edit
+std::vector<cv::Point2f> livePath;                      // Latest smoothed live path
 
 // Draws the grid with obstacles, start and goal
 void drawGrid() {
@@ -43,16 +49,37 @@ void drawGrid() {
         }
     }
 
+    // Shade soft-cost cells darker with cost
+    if (!overlays.costs.empty())
+        for (int r = 0; r < gridSize; ++r)
+            for (int c = 0; c < gridSize; ++c)
+                if (int level = overlays.costs.level(r, c)) {
+                    int shade = std::max(80, 240 - level);
+                    cv::rectangle(gridImg, cv::Rect(c * cellSize, r * cellSize, cellSize, cellSize), cv::Scalar(shade, shade, shade), cv::FILLED);
+                }
+
     // Draw obstacles as filled black squares
     for (auto& obs : obstacles)
         cv::rectangle(gridImg, cv::Rect(obs.second * cellSize, obs.first * cellSize, cellSize, cellSize), cv::Scalar(0, 0, 0), cv::FILLED);
+    for (auto& poly : overlays.polygons.polygons()) {
+        std::vector<cv::Point> pts(poly.begin(), poly.end());
+        cv::fillPoly(gridImg, std::vector<std::vector<cv::Point>>{pts}, cv::Scalar(0, 0, 0));
+    }
 
-    // Draw start and goal points
+    // Draw committed agents as rings, current start and goal as filled points
+    for (auto& agent : agents) {
+        cv::circle(gridImg, cv::Point(agent.first.x * cellSize + cellSize / 2, agent.first.y * cellSize + cellSize / 2), 6, cv::Scalar(0, 255, 0), 2);
+        cv::circle(gridImg, cv::Point(agent.second.x * cellSize + cellSize / 2, agent.second.y * cellSize + cellSize / 2), 6, cv::Scalar(0, 0, 255), 2);
+    }
     if (start.x != -1)
         cv::circle(gridImg, cv::Point(start.x * cellSize + cellSize / 2, start.y * cellSize + cellSize / 2), 6, cv::Scalar(0, 255, 0), -1);
     if (goal.x != -1)
         cv::circle(gridImg, cv::Point(goal.x * cellSize + cellSize / 2, goal.y * cellSize + cellSize / 2), 6, cv::Scalar(0, 0, 255), -1);
 
+    // Overlay the latest live plan
+    for (size_t i = 1; i < livePath.size(); ++i)
+        cv::line(gridImg, livePath[i - 1], livePath[i], cv::Scalar(255, 150, 0), 2);
+
     cv::imshow("Grid Setup", gridImg);
 }
 
@@ -73,6 +100,7 @@ void mouseCallback(int event, int x, int y, int, void*) {
         }
         undoStack.push(cell);
         while (!redoStack.empty()) redoStack.pop();
+        mapDirty = true;
     } else if (event == cv::EVENT_RBUTTONDOWN) {
         // Right-click sets start or goal
         if (selectingStart) {
@@ -81,64 +109,91 @@ void mouseCallback(int event, int x, int y, int, void*) {
         } else {
             goal = cv::Point(col, row);
         }
+        mapDirty = true;
     }
     drawGrid();
 }
 
-// Checks if a point is inside the grid boundaries
-bool isInsideGrid(const cv::Point2f& pt) {
-    int r = pt.y / cellSize, c = pt.x / cellSize;
-    return (r >= 0 && r < gridSize && c >= 0 && c < gridSize);
-}
-
-// Checks if a point lies in an obstacle
-bool isObstacle(const cv::Point2f& pt) {
-    if (!isInsideGrid(pt)) return true;
-    int r = pt.y / cellSize, c = pt.x / cellSize;
-    return obstacles.count({r, c});
-}
-
-// Checks if the path between two points is collision-free
-bool collisionFree(const cv::Point2f& a, const cv::Point2f& b) {
-    for (int i = 1; i <= 10; ++i) {
-        cv::Point2f pt = a + (b - a) * (i / 10.0f);
-        if (!isInsideGrid(pt) || isObstacle(pt)) return false;
+// Restarts the live plan after an edit and gives it a slice of time; called from the UI loop
+void updateLivePlan(const PlannerParams& baseParams) {
+    if (mapDirty) {
+        mapDirty = false;
+        if (liveTask) liveTask->cancel();
+        liveTask.reset();
+        livePath.clear();
+
+        if (livePlanning && steering == SteeringMode::Straight && start.x != -1 && goal.x != -1) {
+            // Each plan gets its own grid snapshot, kept alive until the plan finishes
+            auto grid = std::make_shared<OccupancyGrid>(buildOccupancyGrid(obstacles, gridSize, cellSize));
+            overlays.attach(*grid);
+            PlannerParams params = baseParams;
+            params.anytime = true;
+            params.hierarchical = hierarchical;
+            params.narrowPassage = narrowPassage;
+
+            cv::Point2f startPt(start.x * cellSize + cellSize / 2, start.y * cellSize + cellSize / 2);
+            cv::Point2f goalPt(goal.x * cellSize + cellSize / 2, goal.y * cellSize + cellSize / 2);
+            auto onImproved = [grid](const PlanProgress& progress) {
+                if (!liveTask || progress.id != liveTask->id()) return;
+                livePath = smoothPath(*grid, progress.path);
+                drawGrid();
+            };
+            liveTask = liveExecutor.submit(*grid, canvasSize, startPt, goalPt, params, std::random_device{}(), onImproved,
+                                           [grid](const PlanResult&) {});
+        }
+        drawGrid();
     }
-    return true;
-}
 
-// Euclidean distance between two points
-float dist(const cv::Point2f& a, const cv::Point2f& b) {
-    return cv::norm(a - b);
+    // Bounded slice so key and mouse handling stay responsive
+    liveExecutor.runFor(std::chrono::milliseconds(5));
 }
 
-// Smooth the found path using collision checks
-std::vector<cv::Point2f> smoothPath(const std::vector<Node>& tree, int goalIdx) {
-    std::vector<cv::Point2f> path;
-    for (int cur = goalIdx; cur != -1; cur = tree[cur].parent)
-        path.push_back(tree[cur].point);
-    std::reverse(path.begin(), path.end());
-
-    std::vector<cv::Point2f> smoothed = { path.front() };
-    for (int i = 0, j; i < path.size() - 1; i = j) {
-        for (j = path.size() - 1; j > i; --j)
-            if (collisionFree(path[i], path[j])) break;
-        smoothed.push_back(path[j]);
+int main(int argc, char** argv) {
+    // Optional map file and planner profile: RRTGrid [--map FILE] [--profile FILE]
+    PlannerParams params;
+    MapFile map;
+    bool mapLoaded = false;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--map")) mapLoaded = loadMap(argv[i + 1], map, canvasSize);
+        else if (!std::strcmp(argv[i], "--profile")) loadProfile(argv[i + 1], params);
+    }
+    hierarchical = params.hierarchical;
+    narrowPassage = params.narrowPassage;
+    clearanceSmoothing = params.clearanceSmoothing;
+    steering = params.steering;
+
+    if (mapLoaded) {
+        gridSize = map.gridSize;
+        obstacles = map.obstacles;
+        start = map.start;
+        goal = map.goal;
+        selectingStart = start.x == -1;
+    } else {
+        std::cout << "Enter grid size: ";
+        std::cin >> gridSize;
+        if (gridSize <= 0 || gridSize > canvasSize) {
+            std::cout << "Grid size must be between 1 and " << canvasSize << "\n";
+            return 1;
+        }
     }
-    return smoothed;
-}
-
-int main() {
-    std::cout << "Enter grid size: ";
-    std::cin >> gridSize;
     cellSize = canvasSize / gridSize;
 
+    if (mapLoaded) overlays.build(map, cellSize);
+
     cv::namedWindow("Grid Setup");
     cv::setMouseCallback("Grid Setup", mouseCallback);
     drawGrid();
 
     std::cout << "Left-click to toggle obstacles.\nRight-click to set start(green) and goal(red)\n";
-    std::cout << "Press 's' to start RRT*.\nPress 'u' to undo and 'r' to redo.";
+    std::cout << "Press 's' to start RRT*.\nPress 'u' to undo and 'r' to redo.\n";
+    std::cout << "Press 'h' to toggle coarse-to-fine (corridor) sampling.\n";
+    std::cout << "Press 'n' to toggle narrow-passage (bridge/Gaussian) sampling.\n";
+    std::cout << "Press 'k' to toggle clearance-aware path smoothing.\n";
+    std::cout << "Press 'c' to cycle steering: straight, Dubins, Reeds-Shepp.\n";
+    std::cout << "Press 'v' to toggle the visibility-graph planner.\n";
+    std::cout << "Press 'l' to toggle live replanning while editing.\n";
+    std::cout << "Press 'w' to write the map to grid.map.\n";
+    std::cout << "Press 'a' to add the current start/goal as an agent (multi-agent mode).\n";
 
     // Wait for user to set up grid
     while (!configured) {
@@ -149,102 +204,168 @@ int main() {
             if (obstacles.count(cell)) obstacles.erase(cell);
             else obstacles.insert(cell);
             redoStack.push(cell);
-            drawGrid();
+            mapDirty = true;
         } else if (key == 'r' && !redoStack.empty()) {
             // Redo last undo
             auto cell = redoStack.top(); redoStack.pop();
             if (obstacles.count(cell)) obstacles.erase(cell);
             else obstacles.insert(cell);
             undoStack.push(cell);
-            drawGrid();
-        } else if (key == 's' && start.x != -1 && goal.x != -1) {
+            mapDirty = true;
+        } else if (key == 'h') {
+            // Toggle coarse-to-fine planning
+            hierarchical = !hierarchical;
+            std::cout << "Coarse-to-fine sampling " << (hierarchical ? "enabled" : "disabled") << "\n";
+            mapDirty = true;
+        } else if (key == 'n') {
+            // Toggle narrow-passage samplers
+            narrowPassage = !narrowPassage;
+            std::cout << "Narrow-passage sampling " << (narrowPassage ? "enabled" : "disabled") << "\n";
+            mapDirty = true;
+        } else if (key == 'k') {
+            // Toggle clearance-aware smoothing of the final path
+            if (steering != SteeringMode::Straight) {
+                std::cout << "Clearance smoothing is not supported with car-like steering\n";
+            } else {
+                clearanceSmoothing = !clearanceSmoothing;
+                std::cout << "Clearance smoothing " << (clearanceSmoothing ? "enabled" : "disabled") << "\n";
+            }
+        } else if (key == 'c') {
+            // Cycle steering mode
+            steering = (SteeringMode)(((int)steering + 1) % 3);
+            const char* names[] = {"straight", "Dubins", "Reeds-Shepp"};
+            std::cout << "Steering: " << names[(int)steering] << "\n";
+            if (steering != SteeringMode::Straight && clearanceSmoothing) {
+                clearanceSmoothing = false;
+                std::cout << "Clearance smoothing disabled: not supported with car-like steering\n";
+            }
+            mapDirty = true;
+        } else if (key == 'v') {
+            // Toggle visibility-graph planning
+            visibilityMode = !visibilityMode;
+            std::cout << "Visibility graph: " << (visibilityMode ? "on" : "off") << "\n";
+        } else if (key == 'l') {
+            // Toggle live replanning
+            livePlanning = !livePlanning;
+            std::cout << "Live replanning " << (livePlanning ? "enabled" : "disabled") << "\n";
+            mapDirty = true;
+        } else if (key == 'w') {
+            // Save the map, e.g. for the RRTTune map set
+            map.gridSize = gridSize;
+            map.obstacles = obstacles;
+            map.start = start;
+            map.goal = goal;
+            std::cout << (saveMap("grid.map", map) ? "Map written to grid.map\n" : "Cannot write grid.map\n");
+        } else if (key == 'a' && start.x != -1 && goal.x != -1) {
+            // Commit the current pair as an agent and select the next one
+            agents.push_back({start, goal});
+            start = goal = cv::Point(-1, -1);
+            selectingStart = true;
+            std::cout << "Agent " << agents.size() << " added\n";
+            mapDirty = true;
+        } else if (key == 's' && ((start.x != -1 && goal.x != -1) || !agents.empty())) {
             // Start RRT* when setup is complete
             configured = true;
         }
+        if (!configured) updateLivePlan(params);
     }
 
+    // Drop the live plan and its overlay before the final run
+    if (liveTask) liveTask->cancel();
+    livePath.clear();
+    drawGrid();
     cv::destroyWindow("Grid Setup");
     cv::Mat img = gridImg.clone();
 
-    // Convert start and goal to pixel positions
-    cv::Point2f startPt(start.x * cellSize + cellSize / 2, start.y * cellSize + cellSize / 2);
-    cv::Point2f goalPt(goal.x * cellSize + cellSize / 2, goal.y * cellSize + cellSize / 2);
-
-    // RRT* tree initialization
-    std::vector<Node> tree = {{startPt, -1, 0}};
-    std::mt19937 rng(std::random_device{}());
-    std::uniform_real_distribution<float> dis(0, canvasSize);
-    const int MAX_ITER = 10000;
-    int goalIdx = -1;
-
-    // Main RRT* loop
-    for (int i = 0; i < MAX_ITER; ++i) {
-        // Sample a random point (goal-biased every 5th iteration)
-        cv::Point2f randPt = (i % 5 == 0) ? goalPt : clampToGrid(cv::Point2f(dis(rng), dis(rng)));
-        if (!isInsideGrid(randPt) || isObstacle(randPt)) continue;
-
-        // Find nearest tree node to sampled point
-        int nearest = -1;
-        float bestDist = 1e9;
-        for (int j = 0; j < tree.size(); ++j) {
-            float d = dist(tree[j].point, randPt);
-            if (d < bestDist) bestDist = d, nearest = j;
-        }
-
-        // Move in the direction of the random point with a step limit
-        float stepSize = std::min(50.0f, bestDist);
-        cv::Point2f dir = randPt - tree[nearest].point;
-        if (cv::norm(dir) == 0) continue;
-        dir *= stepSize / cv::norm(dir);
-        cv::Point2f newPt = clampToGrid(tree[nearest].point + dir);
-
-        if (!isInsideGrid(newPt) || !collisionFree(tree[nearest].point, newPt)) continue;
-
-        // Choose best parent based on cost within neighborhood radius
-        int bestParent = nearest;
-        float bestCost = tree[nearest].cost + dist(tree[nearest].point, newPt);
-        float radius = 50.0f * std::sqrt(std::log(tree.size() + 1) / (tree.size() + 1));
-
-        for (int j = 0; j < tree.size(); ++j) {
-            if (dist(tree[j].point, newPt) < radius && collisionFree(tree[j].point, newPt)) {
-                float cost = tree[j].cost + dist(tree[j].point, newPt);
-                if (cost < bestCost) {
-                    bestCost = cost;
-                    bestParent = j;
-                }
-            }
-        }
-
-        // Add new node to the tree
-        int newIdx = tree.size();
-        tree.push_back({newPt, bestParent, bestCost});
-        cv::line(img, tree[bestParent].point, newPt, cv::Scalar(0, 200, 255), 1);
-
-        // Rewire nearby nodes if new path is better
-        for (int j = 0; j < tree.size(); ++j) {
-            if (j == newIdx) continue;
-            if (dist(tree[j].point, newPt) < radius && collisionFree(newPt, tree[j].point)) {
-                float newCost = bestCost + dist(newPt, tree[j].point);
-                if (newCost < tree[j].cost) {
-                    tree[j].parent = newIdx;
-                    tree[j].cost = newCost;
-                }
-            }
+    OccupancyGrid occGrid = buildOccupancyGrid(obstacles, gridSize, cellSize);
+    overlays.attach(occGrid);
+    ObstacleRects obstacleRects;
+    obstacleRects.build(occGrid);
+    occGrid.rects = &obstacleRects;
+    DistanceField distanceField;
+    if (clearanceSmoothing) {
+        distanceField.build(occGrid);
+        occGrid.distance = &distanceField;
+    }
+    params.hierarchical = hierarchical;
+    params.narrowPassage = narrowPassage;
+    params.clearanceSmoothing = clearanceSmoothing;
+    params.steering = steering;
+
+    auto toPixel = [](const cv::Point& cell) {
+        return cv::Point2f(cell.x * cellSize + cellSize / 2, cell.y * cellSize + cellSize / 2);
+    };
+
+    if (!agents.empty()) {
+        // Prioritized multi-agent planning in the order agents were added
+        if (start.x != -1 && goal.x != -1) agents.push_back({start, goal});
+        std::vector<AgentTask> tasks;
+        for (auto& agent : agents) tasks.push_back({toPixel(agent.first), toPixel(agent.second)});
+
+        auto plans = planMultiAgent(occGrid, canvasSize, tasks, params, ReservationConfig(), std::random_device{}());
+        for (size_t a = 0; a < plans.size(); ++a) {
+            cv::Scalar color((a * 97) % 256, (a * 57 + 80) % 256, (a * 151 + 160) % 256);
+            for (size_t i = 1; i < plans[a].path.size(); ++i)
+                cv::line(img, plans[a].path[i - 1], plans[a].path[i], color, 2);
+            if (!plans[a].found) std::cout << "No path found for agent " << a + 1 << ".\n";
         }
+        cv::imshow("RRT*", img);
+        cv::waitKey(0);
+        return 0;
+    }
 
-        // Check if goal is reached
-        if (dist(newPt, goalPt) < cellSize * 0.6f) {
-            goalIdx = newIdx;
-            break;
-        }
+    std::vector<cv::Point2f> smoothed;
+    if (visibilityMode && steering == SteeringMode::Straight) {
+        // Shortest path through convex obstacle corners, graph edges drawn underneath
+        auto graph = cachedVisibilityGraph(occGrid, gridVersion(occGrid));
+        for (size_t i = 0; i < graph->corners.size(); ++i)
+            for (int k = graph->edgeStart[i]; k < graph->edgeStart[i + 1]; ++k)
+                if (graph->edgeTo[k] > (int)i) cv::line(img, graph->corners[i], graph->corners[graph->edgeTo[k]], cv::Scalar(220, 220, 220), 1);
+        smoothed = visibilityPath(*graph, occGrid, toPixel(start), toPixel(goal));
+    }
 
+    // Animate the tree as it grows
+    PlannerHooks hooks;
+    hooks.onCorridor = [&](const Corridor& corridor) {
+        if (corridor.empty())
+            std::cout << "Coarse search found no corridor, sampling globally.\n";
+        for (auto& c : corridor.cells)
+            cv::rectangle(img, cv::Rect(c.x * corridor.cellPx, c.y * corridor.cellPx, corridor.cellPx, corridor.cellPx), cv::Scalar(180, 230, 180), 1);
+    };
+    hooks.onEdge = [&](const cv::Point2f& from, const cv::Point2f& to) {
+        cv::line(img, from, to, cv::Scalar(0, 200, 255), 1);
+    };
+    hooks.onIteration = [&](int) {
         cv::imshow("RRT*", img);
         cv::waitKey(1);
+    };
+
+    std::mt19937 rng(std::random_device{}());
+    if (steering != SteeringMode::Straight) {
+        // Car-like planning, start facing towards the goal
+        if (occGrid.costs) std::cout << "Cost map ignored: car-like steering plans by curve length.\n";
+        cv::Point2f startPt = toPixel(start), goalPt = toPixel(goal);
+        Pose startPose = {startPt.x, startPt.y, std::atan2(goalPt.y - startPt.y, goalPt.x - startPt.x)};
+        CarPlanResult carResult = planCarRRTStar(occGrid, canvasSize, startPose, goalPt, params, rng, hooks);
+        for (size_t i = 1; i < carResult.path.size(); ++i)
+            cv::line(img, cv::Point2f(carResult.path[i - 1].x, carResult.path[i - 1].y),
+                     cv::Point2f(carResult.path[i].x, carResult.path[i].y), cv::Scalar(255, 0, 0), 2);
+        if (!carResult.found()) std::cout << "No path found.\n";
+        cv::imshow("RRT*", img);
+        cv::waitKey(0);
+        return 0;
+    }
+    if (!visibilityMode) {
+        if (params.compactTree) {
+            CompactPlanResult result = planCompactRRTStar(occGrid, canvasSize, toPixel(start), toPixel(goal), params, rng, hooks);
+            smoothed = result.smoothed;
+        } else {
+            smoothed = planRRTStar(occGrid, canvasSize, toPixel(start), toPixel(goal), params, rng, hooks).smoothed;
+        }
     }
 
     // Draw smoothed path if found
-    if (goalIdx != -1) {
-        auto smoothed = smoothPath(tree, goalIdx);
+    if (!smoothed.empty()) {
         for (size_t i = 1; i < smoothed.size(); ++i)
             cv::line(img, smoothed[i - 1], smoothed[i], cv::Scalar(255, 0, 0), 2);
     } else {
@@ -254,4 +375,4 @@ int main() {
     cv::imshow("RRT*", img);
     cv::waitKey(0);
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,47 @@
+#include "map_deltas.h"
+
+MapDeltaStream::MapDeltaStream(OccupancyGrid& grid) : grid_(grid) {
+    ring_.init();
+}
+
+MapDeltaStream::~MapDeltaStream() {
+    std::vector<CellDelta>* batch;
+    while (ring_.pop(batch)) delete batch;
+}
+
+bool MapDeltaStream::publish(const std::vector<CellDelta>& batch) {
+    auto* copy = new std::vector<CellDelta>(batch);
+    if (ring_.push(copy)) return true;
+    delete copy;
+    return false;
+}
+
+void MapDeltaStream::maintain(ObstacleRects* rects, DistanceField* distance, int bucketCells) {
+    rects_ = rects;
+    distance_ = distance;
+    bucketCells_ = bucketCells;
+}
+
+const std::vector<CellDelta>& MapDeltaStream::apply() {
+    changed_.clear();
+    std::vector<CellDelta>* batch;
+    while (ring_.pop(batch)) {
+        for (const CellDelta& d : *batch) {
+            if (!grid_.inside(d.row, d.col)) continue;
+            uint8_t& cell = grid_.cells[d.row * grid_.cols + d.col];
+            if (cell == (d.occupied ? 1 : 0)) continue;
+            cell = d.occupied ? 1 : 0;
+            changed_.push_back({d.row, d.col, cell});
+        }
+        delete batch;
+        ++version_;
+    }
+    if (changed_.empty()) return changed_;
+
+    // Whole rebuilds: batches are infrequent next to the segment checks they speed up
+    if (rects_) rects_->build(grid_, bucketCells_);
+    grid_.rects = grid_.rects == rects_ ? rects_ : nullptr;
+    if (distance_) distance_->build(grid_);
+    grid_.distance = grid_.distance == distance_ ? distance_ : nullptr;
+    return changed_;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "distance_field.h"
+#include "obstacle_rects.h"
+#include "occupancy_grid.h"
+#include "shm_ring.h"
+#include <cstdint>
+#include <vector>
+
+// One cell update from a sensor
+struct CellDelta {
+    int32_t row, col;
+    uint8_t occupied;           // New state: 1 = obstacle, 0 = free
+};
+
+// Stream of batched cell updates into a grid that planners are running on.
+// Producers publish whole batches from any thread through a lock-free ring;
+// the planner thread applies them at iteration boundaries, so the grid never
+// changes while an edge is being checked.
+class MapDeltaStream {
+public:
+    static const size_t CAPACITY = 1024;    // Batches in flight
+
+    // grid is modified in place by apply(); it must use its own cells, not a view
+    explicit MapDeltaStream(OccupancyGrid& grid);
+    ~MapDeltaStream();
+
+    // Any thread. Returns false (and drops the batch) if the ring is full.
+    bool publish(const std::vector<CellDelta>& batch);
+
+    // Derived structures to rebuild whenever apply() changes a cell (either
+    // may be null). The grid's own rects/distance pointers are cleared on a
+    // change unless they point at one of these, so no stale copy is consulted.
+    void maintain(ObstacleRects* rects, DistanceField* distance, int bucketCells = 8);
+
+    // Planner thread. Applies every queued batch and returns the cells whose
+    // state actually changed; empty if nothing was pending.
+    const std::vector<CellDelta>& apply();
+
+    uint64_t version() const { return version_; }   // Number of batches applied
+
+private:
+    OccupancyGrid& grid_;
+    ShmRing<std::vector<CellDelta>*, CAPACITY> ring_;
+    std::vector<CellDelta> changed_;
+    ObstacleRects* rects_ = nullptr;
+    DistanceField* distance_ = nullptr;
+    int bucketCells_ = 8;
+    uint64_t version_ = 0;
+};
@@ -0,0 +1,107 @@
+#include "map_io.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+bool loadMap(const std::string& path, MapFile& map, int canvasSize) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cout << "Cannot open map " << path << "\n";
+        return false;
+    }
+
+    map = MapFile();
+    std::string line;
+    int row = 0;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+
+        if (map.gridSize > 0 && (line[0] == '#' || line[0] == '.' || std::isdigit((unsigned char)line[0]))) {
+            // Grid rows
+            if (row >= map.gridSize || (int)line.size() < map.gridSize) break;
+            for (int c = 0; c < map.gridSize; ++c) {
+                if (line[c] == '#') map.obstacles.insert({row, c});
+                if (line[c] >= '1' && line[c] <= '9') {
+                    map.costLevels.resize((size_t)map.gridSize * map.gridSize, 0);
+                    map.costLevels[row * map.gridSize + c] = 16 * (line[c] - '0');
+                }
+            }
+            ++row;
+            continue;
+        }
+        if (line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+        if (key == "size") fields >> map.gridSize;
+        else if (key == "start") fields >> map.start.x >> map.start.y;
+        else if (key == "goal") fields >> map.goal.x >> map.goal.y;
+        else if (key == "poly") {
+            std::vector<cv::Point2f> poly;
+            float x, y;
+            while (fields >> x >> y) poly.push_back(cv::Point2f(x, y));
+            if (poly.size() >= 3) map.polygons.push_back(poly);
+        }
+    }
+
+    if (map.gridSize <= 0 || row != map.gridSize) {
+        std::cout << "Malformed map " << path << "\n";
+        return false;
+    }
+    if (map.gridSize > canvasSize) {
+        std::cout << "Malformed map " << path << ": size " << map.gridSize << " exceeds the " << canvasSize
+                  << " px canvas\n";
+        return false;
+    }
+    // Unset points are (-1, -1); anything else must be a cell of the grid
+    auto inGrid = [&](const cv::Point& p) {
+        return (p.x == -1 && p.y == -1) || (p.x >= 0 && p.x < map.gridSize && p.y >= 0 && p.y < map.gridSize);
+    };
+    if (!inGrid(map.start) || !inGrid(map.goal)) {
+        std::cout << "Malformed map " << path << ": start or goal outside the grid\n";
+        return false;
+    }
+    return true;
+}
+
+void MapOverlays::build(const MapFile& map, int cellSize) {
+    // Polygon vertices are stored in cell units
+    std::vector<Polygon> polys = map.polygons;
+    for (auto& poly : polys)
+        for (auto& p : poly) p *= (float)cellSize;
+    polygons.build(polys);
+    costs = CostMap();
+    if (!map.costLevels.empty()) costs.build(map.gridSize, map.gridSize, cellSize, map.costLevels);
+}
+
+void MapOverlays::attach(OccupancyGrid& grid) const {
+    grid.polygons = polygons.empty() ? nullptr : &polygons;
+    grid.costs = costs.empty() ? nullptr : &costs;
+}
+
+bool saveMap(const std::string& path, const MapFile& map) {
+    std::ofstream out(path);
+    if (!out) return false;
+    out << "size " << map.gridSize << "\n";
+    if (map.start.x != -1) out << "start " << map.start.x << " " << map.start.y << "\n";
+    if (map.goal.x != -1) out << "goal " << map.goal.x << " " << map.goal.y << "\n";
+    for (auto& poly : map.polygons) {
+        out << "poly";
+        for (auto& p : poly) out << " " << p.x << " " << p.y;
+        out << "\n";
+    }
+    for (int r = 0; r < map.gridSize; ++r) {
+        for (int c = 0; c < map.gridSize; ++c) {
+            int level = map.costLevels.empty() ? 0 : map.costLevels[r * map.gridSize + c];
+            if (map.obstacles.count({r, c})) out << '#';
+            else if (level > 0) out << (char)('0' + std::clamp((level + 8) / 16, 1, 9));
+            else out << '.';
+        }
+        out << "\n";
+    }
+    return (bool)out;
+}
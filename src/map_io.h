@@ -0,0 +1,43 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include "occupancy_grid.h"
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Map loaded from or saved to a text file:
+//   size N
+//   start X Y      (optional, grid coordinates)
+//   goal X Y       (optional)
+//   poly X1 Y1 X2 Y2 X3 Y3 ...   (optional, repeatable; vertices in grid cell units)
+// followed by N rows of N characters, '#' for obstacles and '.' for free cells;
+// a digit 1-9 is a free cell costing that much extra per pixel (cost level 16 * digit).
+// Lines starting with '#' before the size line are comments.
+struct MapFile {
+    int gridSize = 0;
+    std::set<std::pair<int, int>> obstacles;   // (row, col) like the editor
+    cv::Point start{-1, -1}, goal{-1, -1};
+    std::vector<std::vector<cv::Point2f>> polygons;   // Polygon obstacles in cell units
+    std::vector<uint8_t> costLevels;                  // Row-major CostMap levels; empty if every cell is plain
+};
+
+// Returns false and prints the reason if the file cannot be read, has more
+// cells per side than canvasSize pixels, or puts start/goal outside the grid
+bool loadMap(const std::string& path, MapFile& map, int canvasSize);
+
+bool saveMap(const std::string& path, const MapFile& map);
+
+// Polygon obstacles and soft costs of a map file scaled to a cell size, kept
+// together so every grid built from the file can point at them
+struct MapOverlays {
+    PolygonBVH polygons;
+    CostMap costs;
+
+    void build(const MapFile& map, int cellSize);
+    size_t bytes() const { return polygons.bytes() + costs.bytes(); }   // Heap storage, excluding sizeof(*this)
+
+    // Points grid at the overlays the map actually has
+    void attach(OccupancyGrid& grid) const;
+};
@@ -0,0 +1,79 @@
+#include "map_registry.h"
+#include "map_io.h"
+
+MapRegistry::MapRegistry(const std::string& directory, size_t memoryCap, int canvasSize)
+    : directory_(directory), memoryCap_(memoryCap), canvasSize_(canvasSize) {}
+
+std::shared_ptr<MapSnapshot> MapRegistry::load(const std::string& id) const {
+    MapFile file;
+    if (!loadMap(directory_ + "/" + id + ".map", file, canvasSize_)) return nullptr;
+
+    auto snapshot = std::make_shared<MapSnapshot>();
+    snapshot->id = id;
+    int cellSize = canvasSize_ / file.gridSize;
+    snapshot->grid = buildOccupancyGrid(file.obstacles, file.gridSize, cellSize);
+    snapshot->overlays.build(file, cellSize);
+    snapshot->overlays.attach(snapshot->grid);
+    snapshot->start = file.start;
+    snapshot->goal = file.goal;
+    snapshot->bytes = sizeof(MapSnapshot) + snapshot->grid.cells.capacity() + snapshot->overlays.bytes();
+    return snapshot;
+}
+
+std::shared_ptr<const MapSnapshot> MapRegistry::acquire(const std::string& id) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(id);
+        if (it != entries_.end()) {
+            ++hits_;
+            lru_.splice(lru_.begin(), lru_, it->second.lru);
+            return it->second.snapshot;
+        }
+        ++misses_;
+    }
+
+    // Parse outside the lock so other sites stay available meanwhile
+    std::shared_ptr<MapSnapshot> loaded = load(id);
+    if (!loaded) return nullptr;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(id);
+    if (it != entries_.end()) {
+        // Another thread loaded it first
+        lru_.splice(lru_.begin(), lru_, it->second.lru);
+        return it->second.snapshot;
+    }
+    loaded->version = nextVersion_++;
+    lru_.push_front(id);
+    entries_[id] = {loaded, lru_.begin()};
+    resident_ += loaded->bytes;
+    evictLocked();
+    return loaded;
+}
+
+void MapRegistry::invalidate(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(id);
+    if (it == entries_.end()) return;
+    resident_ -= it->second.snapshot->bytes;
+    lru_.erase(it->second.lru);
+    entries_.erase(it);
+}
+
+// Walk from the least recently used end, skipping maps queries still hold
+void MapRegistry::evictLocked() {
+    for (auto it = lru_.end(); resident_ > memoryCap_ && it != lru_.begin();) {
+        --it;
+        auto entry = entries_.find(*it);
+        if (entry->second.snapshot.use_count() > 1) continue;
+        resident_ -= entry->second.snapshot->bytes;
+        entries_.erase(entry);
+        it = lru_.erase(it);
+        ++evictions_;
+    }
+}
+
+size_t MapRegistry::residentBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return resident_;
+}
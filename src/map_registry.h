@@ -0,0 +1,58 @@
+#pragma once
+
+#include "map_io.h"
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Immutable map snapshot handed to queries
+struct MapSnapshot {
+    std::string id;
+    OccupancyGrid grid;                      // Points at overlays
+    MapOverlays overlays;
+    cv::Point start{-1, -1}, goal{-1, -1};   // Defaults stored in the map file
+    uint64_t version = 0;                    // Increases each time the id is (re)loaded
+    size_t bytes = 0;                        // Memory charged against the registry cap
+};
+
+// Registry of site maps addressed by id, loaded lazily from <directory>/<id>.map.
+// Queries hold a shared_ptr to the snapshot they started with, so eviction or
+// reload never pulls a map out from under them; least recently used maps that
+// no query holds are evicted once the cap is exceeded. Thread-safe.
+class MapRegistry {
+public:
+    MapRegistry(const std::string& directory, size_t memoryCap, int canvasSize);
+
+    // Snapshot for id, loading it on a miss; nullptr if it cannot be loaded
+    std::shared_ptr<const MapSnapshot> acquire(const std::string& id);
+
+    // Drop the cached copy so the next acquire() reads the file again
+    void invalidate(const std::string& id);
+
+    size_t residentBytes() const;
+    size_t hits() const { std::lock_guard<std::mutex> lock(mutex_); return hits_; }
+    size_t misses() const { std::lock_guard<std::mutex> lock(mutex_); return misses_; }
+    size_t evictions() const { std::lock_guard<std::mutex> lock(mutex_); return evictions_; }
+
+private:
+    struct Entry {
+        std::shared_ptr<const MapSnapshot> snapshot;
+        std::list<std::string>::iterator lru;
+    };
+
+    std::shared_ptr<MapSnapshot> load(const std::string& id) const;
+    void evictLocked();
+
+    std::string directory_;
+    size_t memoryCap_;
+    int canvasSize_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::list<std::string> lru_;        // Most recently used first
+    size_t resident_ = 0;
+    uint64_t nextVersion_ = 1;
+    size_t hits_ = 0, misses_ = 0, evictions_ = 0;
+};
@@ -0,0 +1,65 @@
+#include "mapped_grid.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool writeOccupancyFile(const std::string& path, const OccupancyGrid& grid) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+    OccupancyFileHeader header = {{'O', 'C', 'C', '1'}, grid.rows, grid.cols, grid.cellSize};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(grid.data()), (std::streamsize)grid.rows * grid.cols);
+    return (bool)out;
+}
+
+MappedGrid::~MappedGrid() {
+    close();
+}
+
+bool MappedGrid::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cout << "Cannot open occupancy file " << path << "\n";
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(OccupancyFileHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    // The descriptor can be closed once the mapping exists
+    void* base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) return false;
+
+    const auto* header = static_cast<const OccupancyFileHeader*>(base);
+    size_t cells = (size_t)header->rows * header->cols;
+    if (std::memcmp(header->magic, "OCC1", 4) != 0 || header->rows <= 0 || header->cols <= 0 ||
+        (size_t)st.st_size < sizeof(OccupancyFileHeader) + cells) {
+        std::cout << "Malformed occupancy file " << path << "\n";
+        munmap(base, st.st_size);
+        return false;
+    }
+
+    base_ = base;
+    length_ = st.st_size;
+    grid_ = OccupancyGrid();
+    grid_.rows = header->rows;
+    grid_.cols = header->cols;
+    grid_.cellSize = header->cellSize;
+    grid_.view = static_cast<const uint8_t*>(base) + sizeof(OccupancyFileHeader);
+    return true;
+}
+
+void MappedGrid::close() {
+    if (base_) munmap(base_, length_);
+    base_ = nullptr;
+    length_ = 0;
+    grid_ = OccupancyGrid();
+}
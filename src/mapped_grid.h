@@ -0,0 +1,34 @@
+#pragma once
+
+#include "occupancy_grid.h"
+#include <string>
+
+// Binary occupancy file: header followed by rows * cols cell bytes, so the
+// cells can be mapped read-only and shared through the page cache.
+struct OccupancyFileHeader {
+    char magic[4];      // "OCC1"
+    int32_t rows, cols, cellSize;
+};
+
+bool writeOccupancyFile(const std::string& path, const OccupancyGrid& grid);
+
+// Read-only memory mapping of an occupancy file (POSIX). The grid borrows
+// the mapped cells and is valid while this object lives.
+class MappedGrid {
+public:
+    MappedGrid() = default;
+    ~MappedGrid();
+    MappedGrid(const MappedGrid&) = delete;
+    MappedGrid& operator=(const MappedGrid&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    const OccupancyGrid& grid() const { return grid_; }
+    size_t bytes() const { return length_; }
+
+private:
+    void* base_ = nullptr;
+    size_t length_ = 0;
+    OccupancyGrid grid_;
+};
@@ -0,0 +1,82 @@
+#include "multi_agent.h"
+#include "counter_rng.h"
+#include <cmath>
+
+int ReservationTable::cellIndex(const cv::Point2f& pt) const {
+    int r = (int)std::floor(pt.y / grid_.cellSize), c = (int)std::floor(pt.x / grid_.cellSize);
+    return r * grid_.cols + c;
+}
+
+bool ReservationTable::slotFree(int cell, int t) const {
+    auto park = parked_.find(cell);
+    if (park != parked_.end() && t + cfg_.timeMargin >= park->second) return false;
+    for (int dt = -cfg_.timeMargin; dt <= cfg_.timeMargin; ++dt)
+        if (slots_.count(key(cell, t + dt))) return false;
+    return true;
+}
+
+bool ReservationTable::segmentFree(const cv::Point2f& a, float tA, const cv::Point2f& b, float tB) const {
+    return forEachSlot(a, tA, b, tB, [&](int cell, int t) { return slotFree(cell, t); });
+}
+
+bool ReservationTable::trajectoryFree(const std::vector<cv::Point2f>& path) const {
+    float t = 0;
+    for (size_t i = 1; i < path.size(); ++i) {
+        float tNext = t + cv::norm(path[i] - path[i - 1]) / cfg_.speed;
+        if (!segmentFree(path[i - 1], t, path[i], tNext)) return false;
+        t = tNext;
+    }
+
+    // Parking at the goal must not block anyone who passes through it later
+    auto last = lastUse_.find(cellIndex(path.back()));
+    return last == lastUse_.end() || last->second < (int)std::floor(t) - cfg_.timeMargin;
+}
+
+void ReservationTable::reserve(const std::vector<cv::Point2f>& path, int agent) {
+    auto mark = [&](int cell, int t) {
+        slots_[key(cell, t)] = agent;
+        int& last = lastUse_.emplace(cell, t).first->second;
+        last = std::max(last, t);
+        return true;
+    };
+
+    float t = 0;
+    mark(cellIndex(path.front()), 0);
+    for (size_t i = 1; i < path.size(); ++i) {
+        float tNext = t + cv::norm(path[i] - path[i - 1]) / cfg_.speed;
+        forEachSlot(path[i - 1], t, path[i], tNext, mark);
+        t = tNext;
+    }
+    parked_[cellIndex(path.back())] = (int)std::floor(t);
+}
+
+std::vector<AgentPlan> planMultiAgent(const OccupancyGrid& grid, int canvasSize, const std::vector<AgentTask>& agents,
+                                      const PlannerParams& params, const ReservationConfig& cfg, uint32_t seed) {
+    std::vector<AgentPlan> plans(agents.size());
+    ReservationTable table(grid, cfg);
+
+    // Arrival time is path length / speed, whatever the cost map charges
+    PlannerHooks hooks;
+    hooks.edgeValid = [&](const cv::Point2f& from, float fromLength, const cv::Point2f& to, float toLength) {
+        return table.segmentFree(from, fromLength / cfg.speed, to, toLength / cfg.speed);
+    };
+
+    for (size_t a = 0; a < agents.size(); ++a) {
+        AgentPlan& plan = plans[a];
+        for (int attempt = 0; attempt < cfg.attempts && !plan.found; ++attempt) {
+            std::mt19937 rng = streamEngine(seed, a * cfg.attempts + attempt);
+            PlanResult res = planRRTStar(grid, canvasSize, agents[a].start, agents[a].goal, params, rng, hooks);
+            if (!res.found()) continue;
+
+            // Shortcutting and rewiring change arrival times, so re-check the whole trajectory
+            if (table.trajectoryFree(res.smoothed)) plan.path = res.smoothed;
+            else if (table.trajectoryFree(res.path)) plan.path = res.path;
+            plan.found = !plan.path.empty();
+        }
+
+        // An agent without a plan stays at its start for everyone after it
+        if (!plan.found) plan.path = { agents[a].start };
+        table.reserve(plan.path, (int)a);
+    }
+    return plans;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "planner.h"
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+// One agent's query, in pixel coordinates
+struct AgentTask {
+    cv::Point2f start, goal;
+};
+
+// Timing model shared by all agents
+struct ReservationConfig {
+    float speed = 5.0f;     // Pixels travelled per time step
+    int timeMargin = 1;     // Time steps kept clear on either side of a reservation
+    int attempts = 3;       // Planning attempts per agent before it is left at its start
+};
+
+// Hashed (cell, time step) -> agent table of already planned trajectories
+class ReservationTable {
+public:
+    ReservationTable(const OccupancyGrid& grid, const ReservationConfig& cfg) : grid_(grid), cfg_(cfg) {}
+
+    // True if moving from a at tA to b at tB (time steps) meets no reservation
+    bool segmentFree(const cv::Point2f& a, float tA, const cv::Point2f& b, float tB) const;
+
+    // Checks a whole trajectory at constant speed, including parking at its last point
+    bool trajectoryFree(const std::vector<cv::Point2f>& path) const;
+
+    // Reserves a trajectory for an agent, which then stays parked at its last point
+    void reserve(const std::vector<cv::Point2f>& path, int agent);
+
+    void clear() { slots_.clear(); parked_.clear(); lastUse_.clear(); }
+
+private:
+    int cellIndex(const cv::Point2f& pt) const;
+    static uint64_t key(int cell, int t) { return ((uint64_t)(uint32_t)cell << 32) | (uint32_t)t; }
+    bool slotFree(int cell, int t) const;
+
+    // Calls visit(cell, t) for every integer time step spent in every cell
+    // crossed by a-b, from cell entry to cell exit; stops when visit returns false
+    template <typename Visit>
+    bool forEachSlot(const cv::Point2f& a, float tA, const cv::Point2f& b, float tB, Visit visit) const {
+        return traverseCells(grid_.cellSize, a, b, [&](int r, int c, float s0, float s1) {
+            int cell = r * grid_.cols + c;
+            int last = (int)std::floor(tA + (tB - tA) * s1);
+            for (int t = (int)std::floor(tA + (tB - tA) * s0); t <= last; ++t)
+                if (!visit(cell, t)) return false;
+            return true;
+        });
+    }
+
+    const OccupancyGrid& grid_;
+    ReservationConfig cfg_;
+    std::unordered_map<uint64_t, int> slots_;   // (cell, time step) -> agent
+    std::unordered_map<int, int> parked_;       // cell -> time step an agent parks there from
+    std::unordered_map<int, int> lastUse_;      // cell -> last reserved time step
+};
+
+// Result for one agent of a batch
+struct AgentPlan {
+    bool found = false;
+    std::vector<cv::Point2f> path;   // Timed at cfg.speed; a single start point if not found
+};
+
+// Prioritized planning: agents are planned in order, each against the
+// reservations of all earlier agents
+std::vector<AgentPlan> planMultiAgent(const OccupancyGrid& grid, int canvasSize, const std::vector<AgentTask>& agents,
+                                      const PlannerParams& params, const ReservationConfig& cfg, uint32_t seed);
@@ -0,0 +1,80 @@
+#include "obstacle_rects.h"
+#include "occupancy_grid.h"
+#include <algorithm>
+
+// Slab test of segment a-b against a closed box
+static bool segmentHitsRect(const ObstacleRects::Rect& rect, const cv::Point2f& a, const cv::Point2f& b) {
+    float t0 = 0, t1 = 1;
+    const float o[2] = {a.x, a.y}, d[2] = {b.x - a.x, b.y - a.y};
+    const float lo[2] = {rect.x0, rect.y0}, hi[2] = {rect.x1, rect.y1};
+    for (int k = 0; k < 2; ++k) {
+        if (d[k] == 0) {
+            if (o[k] < lo[k] || o[k] > hi[k]) return false;
+            continue;
+        }
+        float ta = (lo[k] - o[k]) / d[k], tb = (hi[k] - o[k]) / d[k];
+        if (ta > tb) std::swap(ta, tb);
+        t0 = std::max(t0, ta), t1 = std::min(t1, tb);
+        if (t0 > t1) return false;
+    }
+    return true;
+}
+
+void ObstacleRects::build(const OccupancyGrid& grid, int bucketCells) {
+    rects_.clear();
+    const uint8_t* cells = grid.data();
+    std::vector<uint8_t> covered((size_t)grid.rows * grid.cols, 0);
+    std::vector<int> cellRects;     // (r0, c0, r1, c1) per rectangle, inclusive
+
+    for (int r = 0; r < grid.rows; ++r) {
+        for (int c = 0; c < grid.cols; ++c) {
+            if (!cells[r * grid.cols + c] || covered[r * grid.cols + c]) continue;
+            int c1 = c;
+            while (c1 + 1 < grid.cols && cells[r * grid.cols + c1 + 1]) ++c1;
+            int r1 = r;
+            while (r1 + 1 < grid.rows) {
+                const uint8_t* row = cells + (r1 + 1) * grid.cols;
+                if (std::find(row + c, row + c1 + 1, 0) != row + c1 + 1) break;
+                ++r1;
+            }
+            for (int rr = r; rr <= r1; ++rr)
+                std::fill(covered.begin() + rr * grid.cols + c, covered.begin() + rr * grid.cols + c1 + 1, 1);
+            cellRects.insert(cellRects.end(), {r, c, r1, c1});
+            float s = (float)grid.cellSize;
+            rects_.push_back({c * s, r * s, (c1 + 1) * s, (r1 + 1) * s});
+        }
+    }
+
+    // Bucket index in CSR form: count, prefix-sum, fill
+    bucketCells = std::max(1, bucketCells);
+    bucketPx_ = bucketCells * grid.cellSize;
+    bucketRows_ = (grid.rows + bucketCells - 1) / bucketCells;
+    bucketCols_ = (grid.cols + bucketCells - 1) / bucketCells;
+    bucketStart_.assign((size_t)bucketRows_ * bucketCols_ + 1, 0);
+    auto forEachBucket = [&](size_t i, auto fn) {
+        const int* cr = &cellRects[i * 4];
+        for (int br = cr[0] / bucketCells; br <= cr[2] / bucketCells; ++br)
+            for (int bc = cr[1] / bucketCells; bc <= cr[3] / bucketCells; ++bc) fn(br * bucketCols_ + bc);
+    };
+    for (size_t i = 0; i < rects_.size(); ++i) forEachBucket(i, [&](int b) { ++bucketStart_[b + 1]; });
+    for (size_t b = 1; b < bucketStart_.size(); ++b) bucketStart_[b] += bucketStart_[b - 1];
+    bucketRects_.assign(bucketStart_.back(), 0);
+    std::vector<int> fill(bucketStart_.begin(), bucketStart_.end() - 1);
+    for (size_t i = 0; i < rects_.size(); ++i) forEachBucket(i, [&](int b) { bucketRects_[fill[b]++] = (int)i; });
+}
+
+bool ObstacleRects::intersects(const cv::Point2f& a, const cv::Point2f& b) const {
+    // Rectangles spanning several buckets may be tested more than once; the slab test is cheaper than deduplicating
+    bool hit = false;
+    traverseCells(bucketPx_, a, b, [&](int br, int bc, float, float) {
+        if (br < 0 || br >= bucketRows_ || bc < 0 || bc >= bucketCols_) return true;
+        int bucket = br * bucketCols_ + bc;
+        for (int k = bucketStart_[bucket]; k < bucketStart_[bucket + 1]; ++k)
+            if (segmentHitsRect(rects_[bucketRects_[k]], a, b)) {
+                hit = true;
+                return false;
+            }
+        return true;
+    });
+    return hit;
+}
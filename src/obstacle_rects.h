@@ -0,0 +1,30 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+struct OccupancyGrid;
+
+// Occupied cells merged into a few axis-aligned rectangles with a bucket index,
+// so a segment check is a handful of slab tests instead of per-cell lookups
+class ObstacleRects {
+public:
+    struct Rect {
+        float x0, y0, x1, y1;       // Pixel bounds
+    };
+
+    // Greedy cover: grow each uncovered occupied cell right, then down, as far as
+    // the occupied cells allow. Rectangles may overlap.
+    void build(const OccupancyGrid& grid, int bucketCells = 8);
+
+    const std::vector<Rect>& rects() const { return rects_; }
+
+    // True if segment a-b touches any rectangle (boundaries included)
+    bool intersects(const cv::Point2f& a, const cv::Point2f& b) const;
+
+private:
+    std::vector<Rect> rects_;
+    int bucketPx_ = 1, bucketRows_ = 0, bucketCols_ = 0;
+    std::vector<int> bucketStart_;  // CSR offsets into bucketRects_, one entry per bucket plus one
+    std::vector<int> bucketRects_;
+};
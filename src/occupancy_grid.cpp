@@ -0,0 +1,38 @@
+#include "occupancy_grid.h"
+
+bool collisionFree(const OccupancyGrid& grid, const cv::Point2f& a, const cv::Point2f& b) {
+    // Polygons are tested exactly; cells exactly through the rectangle cover if present, otherwise sampled
+    if (grid.polygons && grid.polygons->intersects(a, b)) return false;
+    if (grid.rects) return !grid.rects->intersects(a, b) && !grid.occupiedAt(b);
+    for (int i = 1; i <= 10; ++i) {
+        cv::Point2f pt = a + (b - a) * (i / 10.0f);
+        if (grid.occupiedAt(pt)) return false;
+    }
+    return true;
+}
+
+OccupancyGrid buildOccupancyGrid(const std::set<std::pair<int, int>>& obstacles, int gridSize, int cellSize) {
+    OccupancyGrid grid;
+    grid.rows = grid.cols = gridSize;
+    grid.cellSize = cellSize;
+    grid.cells.assign((size_t)gridSize * gridSize, 0);
+    for (auto& obs : obstacles)
+        if (grid.inside(obs.first, obs.second))
+            grid.cells[obs.first * grid.cols + obs.second] = 1;
+    return grid;
+}
+
+OccupancyGrid maxPool(const OccupancyGrid& grid, int factor) {
+    OccupancyGrid coarse;
+    coarse.rows = (grid.rows + factor - 1) / factor;
+    coarse.cols = (grid.cols + factor - 1) / factor;
+    coarse.cellSize = grid.cellSize * factor;
+    coarse.cells.assign((size_t)coarse.rows * coarse.cols, 0);
+
+    // Partial blocks at the right/bottom edge only pool the cells that exist
+    for (int r = 0; r < grid.rows; ++r)
+        for (int c = 0; c < grid.cols; ++c)
+            if (grid.data()[r * grid.cols + c])
+                coarse.cells[(r / factor) * coarse.cols + c / factor] = 1;
+    return coarse;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include "cost_map.h"
+#include "obstacle_rects.h"
+#include "polygon_bvh.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <utility>
+#include <vector>
+
+class DistanceField;
+class TileCache;
+bool tileOccupied(TileCache* tiles, int r, int c);
+
+// Dense row-major occupancy grid built from the obstacle cell set
+struct OccupancyGrid {
+    int rows = 0, cols = 0;         // Grid dimensions in cells
+    int cellSize = 1;               // Size of one cell in pixels
+    std::vector<uint8_t> cells;     // 1 = obstacle, 0 = free
+    const uint8_t* view = nullptr;  // Borrowed cell storage (e.g. a read-only mapping) used instead of cells
+    const PolygonBVH* polygons = nullptr;  // Optional polygon obstacles checked exactly on top of the cells
+    const ObstacleRects* rects = nullptr;  // Optional rectangle cover of the cells for analytic segment checks
+    const CostMap* costs = nullptr;        // Optional soft traversal costs; edge costs are plain lengths without
+    TileCache* tiles = nullptr;            // Out-of-core cells loaded on demand instead of cells/view
+    const DistanceField* distance = nullptr;  // Optional clearance field used by clearance-aware smoothing
+
+    const uint8_t* data() const { return view ? view : cells.data(); }
+
+    // True if (r, c) lies inside the grid
+    bool inside(int r, int c) const { return r >= 0 && r < rows && c >= 0 && c < cols; }
+
+    // Cells outside the grid count as occupied
+    bool occupied(int r, int c) const {
+        if (tiles) return tileOccupied(tiles, r, c);
+        return !inside(r, c) || data()[r * cols + c];
+    }
+
+    // Occupancy of the cell containing a pixel position
+    bool occupiedAt(const cv::Point2f& pt) const {
+        return occupied((int)std::floor(pt.y / cellSize), (int)std::floor(pt.x / cellSize));
+    }
+};
+
+// Checks if a pixel position lies in an obstacle or outside the grid
+inline bool isObstacle(const OccupancyGrid& grid, const cv::Point2f& pt) {
+    return grid.occupiedAt(pt) || (grid.polygons && grid.polygons->contains(pt));
+}
+
+// Checks if the path between two points is collision-free
+bool collisionFree(const OccupancyGrid& grid, const cv::Point2f& a, const cv::Point2f& b);
+
+// Cost of moving along segment a-b: its length, weighted by the cost map if the grid has one
+inline float edgeCost(const OccupancyGrid& grid, const cv::Point2f& a, const cv::Point2f& b) {
+    return grid.costs ? grid.costs->edgeCost(a, b) : (float)cv::norm(b - a);
+}
+
+// Visits every cell crossed by segment a-b in order (Amanatides-Woo traversal).
+// visit(r, c, t0, t1) receives the segment parameter range spent in the cell and
+// returns false to stop early; the return value is false if traversal was stopped.
+// At exact corner crossings the x-neighbour is visited with an empty range.
+template <typename Visit>
+bool traverseCells(int cellSize, const cv::Point2f& a, const cv::Point2f& b, Visit visit) {
+    const float inf = std::numeric_limits<float>::infinity();
+    float x0 = a.x / cellSize, y0 = a.y / cellSize;
+    float dx = b.x / cellSize - x0, dy = b.y / cellSize - y0;
+    int c = (int)std::floor(x0), r = (int)std::floor(y0);
+    int stepC = dx > 0 ? 1 : -1, stepR = dy > 0 ? 1 : -1;
+    int n = std::abs((int)std::floor(x0 + dx) - c) + std::abs((int)std::floor(y0 + dy) - r);
+
+    float tDeltaX = dx != 0 ? std::abs(1.0f / dx) : inf;
+    float tDeltaY = dy != 0 ? std::abs(1.0f / dy) : inf;
+    float tMaxX = dx > 0 ? (c + 1 - x0) / dx : dx < 0 ? (x0 - c) / -dx : inf;
+    float tMaxY = dy > 0 ? (r + 1 - y0) / dy : dy < 0 ? (y0 - r) / -dy : inf;
+
+    float t = 0;
+    for (int i = 0; i < n; ++i) {
+        float tNext = std::min(std::min(tMaxX, tMaxY), 1.0f);
+        if (!visit(r, c, t, tNext)) return false;
+        t = tNext;
+        if (tMaxX <= tMaxY) c += stepC, tMaxX += tDeltaX;
+        else r += stepR, tMaxY += tDeltaY;
+    }
+    return visit(r, c, t, 1.0f);
+}
+
+// Exact check that no cell crossed by segment a-b is occupied and no polygon is touched
+inline bool traversalFree(const OccupancyGrid& grid, const cv::Point2f& a, const cv::Point2f& b) {
+    if (grid.polygons && grid.polygons->intersects(a, b)) return false;
+    return traverseCells(grid.cellSize, a, b, [&](int r, int c, float, float) { return !grid.occupied(r, c); });
+}
+
+// Build a dense grid from the obstacle set used by the editor
+OccupancyGrid buildOccupancyGrid(const std::set<std::pair<int, int>>& obstacles, int gridSize, int cellSize);
+
+// Downsample by an integer factor; a coarse cell is occupied if any covered fine cell is
+OccupancyGrid maxPool(const OccupancyGrid& grid, int factor);
@@ -0,0 +1,51 @@
+#include "plan_executor.h"
+#include "counter_rng.h"
+
+std::shared_ptr<PlanTask> PlanExecutor::submit(const OccupancyGrid& grid, int canvasSize, const cv::Point2f& start,
+                                               const cv::Point2f& goal, const PlannerParams& params, uint32_t seed,
+                                               std::function<void(const PlanProgress&)> onImproved,
+                                               std::function<void(const PlanResult&)> onDone) {
+    auto task = std::make_shared<PlanTask>();
+    PlanTask* t = task.get();
+    t->id_ = nextId_++;
+    t->rng_ = streamEngine(seed, t->id_);
+    t->future_ = t->promise_.get_future().share();
+    t->onDone_ = std::move(onDone);
+
+    // The search keeps its own copy of the hooks; they point back at the task, which outlives it
+    t->hooks_.shouldStop = [t] { return t->cancelled(); };
+    if (onImproved) {
+        t->hooks_.onSolution = [t, onImproved](const std::vector<cv::Point2f>& path, float cost) {
+            onImproved({t->id_, path, cost, t->search_->iterations()});
+        };
+    }
+    t->search_ = std::make_unique<RRTStarSearch>(grid, canvasSize, start, goal, params, t->rng_, t->hooks_);
+    tasks_.push_back(task);
+    return task;
+}
+
+size_t PlanExecutor::poll() {
+    // Finished tasks are swapped out; callbacks may submit new tasks, which start on the next poll
+    size_t count = tasks_.size();
+    for (size_t i = 0; i < count;) {
+        auto task = tasks_[i];
+        if (task->search_->step(sliceIterations_)) {
+            ++i;
+            continue;
+        }
+        PlanResult result = task->search_->finish();
+        task->search_.reset();
+        tasks_[i] = tasks_[count - 1];
+        tasks_.erase(tasks_.begin() + (count - 1));
+        --count;
+        if (task->onDone_) task->onDone_(result);
+        task->promise_.set_value(std::move(result));
+    }
+    return tasks_.size();
+}
+
+size_t PlanExecutor::runFor(std::chrono::microseconds budget) {
+    auto deadline = std::chrono::steady_clock::now() + budget;
+    while (!tasks_.empty() && std::chrono::steady_clock::now() < deadline) poll();
+    return tasks_.size();
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "planner.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+
+// Improved solution published by a running task
+struct PlanProgress {
+    uint64_t id;
+    std::vector<cv::Point2f> path;      // Start-to-goal tree path
+    float cost;
+    int iterations;                     // Iterations run when it was found
+};
+
+// Handle to a plan in flight on a PlanExecutor
+class PlanTask {
+public:
+    uint64_t id() const { return id_; }
+
+    // Stop at the next slice boundary; safe from any thread. The result then
+    // carries the best solution so far with stopped = true.
+    void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+    bool cancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+
+    // Ready once the task has finished or was cancelled; get() blocks, so only
+    // await from a thread other than the one polling the executor
+    std::shared_future<PlanResult> result() const { return future_; }
+    bool ready() const { return future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+private:
+    friend class PlanExecutor;
+
+    uint64_t id_ = 0;
+    std::atomic<bool> cancelled_{false};
+    std::mt19937 rng_;
+    PlannerHooks hooks_;
+    std::unique_ptr<RRTStarSearch> search_;
+    std::promise<PlanResult> promise_;
+    std::shared_future<PlanResult> future_;
+    std::function<void(const PlanResult&)> onDone_;
+};
+
+// Cooperative executor multiplexing many RRT* searches on the thread that
+// polls it: each poll() runs one slice of every live task, so an event loop
+// can interleave planning with its own work and never blocks on a plan.
+// Not thread-safe apart from PlanTask::cancel() and awaiting results.
+class PlanExecutor {
+public:
+    explicit PlanExecutor(int sliceIterations = 100) : sliceIterations_(sliceIterations) {}
+
+    // grid must outlive the task; callbacks run on the polling thread
+    std::shared_ptr<PlanTask> submit(const OccupancyGrid& grid, int canvasSize, const cv::Point2f& start,
+                                     const cv::Point2f& goal, const PlannerParams& params, uint32_t seed,
+                                     std::function<void(const PlanProgress&)> onImproved = {},
+                                     std::function<void(const PlanResult&)> onDone = {});
+
+    // One slice per live task, round robin; returns the number still running
+    size_t poll();
+
+    // Poll until every task is done or the budget is used up
+    size_t runFor(std::chrono::microseconds budget);
+
+    size_t pending() const { return tasks_.size(); }
+
+private:
+    int sliceIterations_;
+    uint64_t nextId_ = 1;
+    std::vector<std::shared_ptr<PlanTask>> tasks_;
+};
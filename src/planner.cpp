@@ -0,0 +1,316 @@
+#include "planner.h"
+#include <algorithm>
+
+// Clamp point within canvas bounds
+static cv::Point2f clampToCanvas(const cv::Point2f& pt, int canvasSize) {
+    float x = std::clamp(pt.x, 0.0f, (float)(canvasSize - 1));
+    float y = std::clamp(pt.y, 0.0f, (float)(canvasSize - 1));
+    return cv::Point2f(x, y);
+}
+
+std::vector<cv::Point2f> extractPath(const std::vector<Node>& tree, int goalIdx) {
+    std::vector<cv::Point2f> path;
+    for (int cur = goalIdx; cur != -1; cur = tree[cur].parent)
+        path.push_back(tree[cur].point);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::vector<cv::Point2f> smoothPath(const OccupancyGrid& grid, const std::vector<cv::Point2f>& path) {
+    if (path.empty()) return path;
+
+    // On a cost map a shortcut must also be no more expensive than the stretch it replaces
+    std::vector<float> costTo(path.size(), 0.0f);
+    if (grid.costs)
+        for (size_t k = 1; k < path.size(); ++k) costTo[k] = costTo[k - 1] + edgeCost(grid, path[k - 1], path[k]);
+    auto worthIt = [&](int i, int j) { return !grid.costs || edgeCost(grid, path[i], path[j]) <= costTo[j] - costTo[i]; };
+
+    std::vector<cv::Point2f> smoothed = { path.front() };
+    for (int i = 0, j; i < (int)path.size() - 1; i = j) {
+        for (j = path.size() - 1; j > i + 1; --j)
+            if (collisionFree(grid, path[i], path[j]) && worthIt(i, j)) break;
+        smoothed.push_back(path[j]);
+    }
+    return smoothed;
+}
+
+std::vector<cv::Point2f> smoothPath(const OccupancyGrid& grid, const std::vector<cv::Point2f>& path,
+                                    const PlannerParams& params) {
+    std::vector<cv::Point2f> smoothed = smoothPath(grid, path);
+    if (!params.clearanceSmoothing || !grid.distance) return smoothed;
+    std::vector<cv::Point2f> optimized;
+    ClearanceSmoother(grid, *grid.distance, params.clearance).smooth(smoothed, optimized);
+    return optimized;
+}
+
+// RRT*-FN eviction: frees a random leaf that is neither on the best path nor
+// `keep`, and returns its slot, or -1 if no such leaf was found in a few tries
+static int evictLeaf(std::vector<Node>& tree, std::vector<int>& children, std::vector<uint8_t>& onBestPath,
+                     int goalIdx, int keep, std::mt19937& rng) {
+    if (tree.size() < 2) return -1;
+    for (int cur = goalIdx; cur != -1; cur = tree[cur].parent) onBestPath[cur] = 1;
+    std::uniform_int_distribution<int> pick(1, (int)tree.size() - 1);
+    int victim = -1;
+    for (int attempt = 0; attempt < 32 && victim == -1; ++attempt) {
+        int j = pick(rng);
+        if (tree[j].parent != EVICTED && children[j] == 0 && !onBestPath[j] && j != keep) victim = j;
+    }
+    for (int cur = goalIdx; cur != -1; cur = tree[cur].parent) onBestPath[cur] = 0;
+
+    if (victim != -1) {
+        --children[tree[victim].parent];
+        tree[victim].parent = EVICTED;
+    }
+    return victim;
+}
+
+RRTStarSearch::RRTStarSearch(const OccupancyGrid& grid, int canvasSize, const cv::Point2f& startPt, const cv::Point2f& goalPt,
+                             const PlannerParams& params, std::mt19937& rng, const PlannerHooks& hooks)
+    : grid_(grid), canvasSize_(canvasSize), goalPt_(goalPt), params_(params), rng_(rng), hooks_(hooks),
+      uniform_(drawSeed(rng), 0, (float)canvasSize) {
+    result_.tree.push_back({startPt, -1, 0});
+    length_.push_back(0);
+
+    // Coarse grid search to find the corridor sampling is restricted to
+    if (params.hierarchical) {
+        cv::Point startCell(startPt.x / grid.cellSize, startPt.y / grid.cellSize);
+        cv::Point goalCell(goalPt.x / grid.cellSize, goalPt.y / grid.cellSize);
+        corridor_ = findCorridor(grid, startCell, goalCell, params.hier);
+        if (hooks.onCorridor) hooks.onCorridor(corridor_);
+    }
+}
+
+bool RRTStarSearch::edgeOk(const cv::Point2f& from, float fromLength, const cv::Point2f& to, float toLength) const {
+    if (!collisionFree(grid_, from, to)) return false;
+    return !hooks_.edgeValid || hooks_.edgeValid(from, fromLength, to, toLength);
+}
+
+bool RRTStarSearch::step(int iterations) {
+    for (int n = 0; n < iterations && !done_; ++n) {
+        if (iter_ >= params_.maxIter) {
+            done_ = true;
+        } else if (hooks_.shouldStop && hooks_.shouldStop()) {
+            result_.stopped = true;
+            done_ = true;
+        } else {
+            if (deltas_) {
+                const std::vector<CellDelta>& changed = deltas_->apply();
+                if (!changed.empty()) pruneBlocked(changed);
+            }
+            iterate(iter_++);
+        }
+    }
+    return !done_;
+}
+
+PlanResult RRTStarSearch::finish() {
+    done_ = true;
+    if (result_.found()) {
+        result_.path = extractPath(result_.tree, result_.goalIdx);
+        result_.smoothed = smoothPath(grid_, result_.path, params_);
+    }
+    return std::move(result_);
+}
+
+// Removes every subtree whose edge from its parent crosses a newly occupied
+// cell; the freed slots are reused like evicted ones
+void RRTStarSearch::pruneBlocked(const std::vector<CellDelta>& changed) {
+    std::vector<Node>& tree = result_.tree;
+    blocked_.assign((size_t)grid_.rows * grid_.cols, 0);
+    int minR = grid_.rows, maxR = -1, minC = grid_.cols, maxC = -1;
+    for (const CellDelta& d : changed) {
+        if (!d.occupied) continue;
+        blocked_[d.row * grid_.cols + d.col] = 1;
+        minR = std::min(minR, d.row), maxR = std::max(maxR, d.row);
+        minC = std::min(minC, d.col), maxC = std::max(maxC, d.col);
+    }
+    if (maxR == -1) return;
+
+    // 0 = unknown, 1 = kept, 2 = pruned; edges outside the changed bounding box are skipped
+    const int UNKNOWN = 0, KEPT = 1, PRUNED = 2;
+    nodeState_.assign(tree.size(), UNKNOWN);
+    nodeState_[0] = KEPT;
+    float cs = (float)grid_.cellSize;
+    for (size_t j = 1; j < tree.size(); ++j) {
+        if (tree[j].parent < 0) continue;
+        const cv::Point2f& a = tree[tree[j].parent].point;
+        const cv::Point2f& b = tree[j].point;
+        if (std::max(a.y, b.y) < minR * cs || std::min(a.y, b.y) >= (maxR + 1) * cs ||
+            std::max(a.x, b.x) < minC * cs || std::min(a.x, b.x) >= (maxC + 1) * cs) continue;
+        bool hit = !traverseCells(grid_.cellSize, a, b, [&](int r, int c, float, float) {
+            return !grid_.inside(r, c) || !blocked_[r * grid_.cols + c];
+        });
+        if (hit) nodeState_[j] = PRUNED;
+    }
+
+    // A node is pruned if anything on its way to the root is
+    std::vector<int>& chain = chain_;
+    for (size_t j = 1; j < tree.size(); ++j) {
+        if (tree[j].parent == EVICTED) continue;
+        int cur = (int)j;
+        while (nodeState_[cur] == UNKNOWN) chain.push_back(cur), cur = tree[cur].parent;
+        for (int k : chain) nodeState_[k] = nodeState_[cur];
+        chain.clear();
+    }
+    for (size_t j = 1; j < tree.size(); ++j) {
+        if (tree[j].parent == EVICTED || nodeState_[j] != PRUNED) continue;
+        if (nodeState_[tree[j].parent] == KEPT) --children_[tree[j].parent];
+        children_[j] = 0;
+        tree[j].parent = EVICTED;
+        freeSlots_.push_back((int)j);
+    }
+
+    // Fall back to the cheapest surviving goal node, if any
+    if (result_.goalIdx != -1 && tree[result_.goalIdx].parent == EVICTED) {
+        result_.goalIdx = -1;
+        for (size_t j = 1; j < tree.size(); ++j)
+            if (tree[j].parent != EVICTED && dist(tree[j].point, goalPt_) < grid_.cellSize * 0.6f &&
+                (result_.goalIdx == -1 || tree[j].cost < tree[result_.goalIdx].cost))
+                result_.goalIdx = (int)j;
+    }
+}
+
+// Passes the cost and length drop of each rewired node on to its whole
+// subtree, so descendants keep exact values for later choose-parent and
+// rewire decisions
+void RRTStarSearch::propagateCosts() {
+    std::vector<Node>& tree = result_.tree;
+    const int UNKNOWN = 0, RESOLVED = 1;
+    nodeState_.assign(tree.size(), UNKNOWN);
+    costDrop_.assign(tree.size(), 0.0f);
+    lengthDrop_.assign(tree.size(), 0.0f);
+    nodeState_[0] = RESOLVED;
+    for (const Rewire& r : rewired_)
+        nodeState_[r.node] = RESOLVED, costDrop_[r.node] = r.costDrop, lengthDrop_[r.node] = r.lengthDrop;
+
+    std::vector<int>& chain = chain_;
+    for (size_t j = 1; j < tree.size(); ++j) {
+        if (tree[j].parent == EVICTED) continue;
+        int cur = (int)j;
+        while (nodeState_[cur] == UNKNOWN) chain.push_back(cur), cur = tree[cur].parent;
+        float drop = costDrop_[cur], lengthDrop = lengthDrop_[cur];
+        for (int k : chain) {
+            nodeState_[k] = RESOLVED;
+            costDrop_[k] = drop;
+            lengthDrop_[k] = lengthDrop;
+            tree[k].cost -= drop;
+            length_[k] -= lengthDrop;
+        }
+        chain.clear();
+    }
+}
+
+void RRTStarSearch::iterate(int i) {
+    std::vector<Node>& tree = result_.tree;
+
+    // Sample a random point (goal-biased every goalBiasPeriod-th iteration)
+    cv::Point2f randPt;
+    if (i % params_.goalBiasPeriod == 0) {
+        randPt = goalPt_;
+    } else if (!params_.narrowPassage || !sampleNarrowPassage(grid_, params_.sampler, rng_, canvasSize_, randPt)) {
+        // Corridor or uniform sampling when no narrow-passage sample was drawn
+        randPt = params_.hierarchical ? sampleCorridor(corridor_, params_.hier, rng_, canvasSize_)
+                                      : clampToCanvas(uniform_.next(), canvasSize_);
+    }
+    if (isObstacle(grid_, randPt)) return;
+
+    // Find nearest tree node to sampled point
+    int nearest = -1;
+    float bestDist = 1e9;
+    for (int j = 0; j < (int)tree.size(); ++j) {
+        if (tree[j].parent == EVICTED) continue;
+        float d = dist(tree[j].point, randPt);
+        if (d < bestDist) bestDist = d, nearest = j;
+    }
+
+    // Move in the direction of the random point with a step limit
+    float stepSize = std::min(params_.stepSize, bestDist);
+    cv::Point2f dir = randPt - tree[nearest].point;
+    if (cv::norm(dir) == 0) return;
+    dir *= stepSize / cv::norm(dir);
+    cv::Point2f newPt = clampToCanvas(tree[nearest].point + dir, canvasSize_);
+
+    float nearestCost = tree[nearest].cost + edgeCost(grid_, tree[nearest].point, newPt);
+    float nearestLength = length_[nearest] + dist(tree[nearest].point, newPt);
+    if (isObstacle(grid_, newPt) || !edgeOk(tree[nearest].point, length_[nearest], newPt, nearestLength)) return;
+
+    // Choose best parent based on cost within neighborhood radius
+    int bestParent = nearest;
+    float bestCost = nearestCost, bestLength = nearestLength;
+    size_t liveNodes = tree.size() - freeSlots_.size();
+    float radius = params_.radiusScale * std::sqrt(std::log(liveNodes + 1) / (liveNodes + 1));
+
+    for (int j = 0; j < (int)tree.size(); ++j) {
+        float d = dist(tree[j].point, newPt);
+        // Edge cost is never below the length, so the length rules out most candidates cheaply
+        if (tree[j].parent != EVICTED && d < radius && tree[j].cost + d < bestCost) {
+            float cost = tree[j].cost + edgeCost(grid_, tree[j].point, newPt);
+            if (cost < bestCost && edgeOk(tree[j].point, length_[j], newPt, length_[j] + d)) {
+                bestCost = cost;
+                bestLength = length_[j] + d;
+                bestParent = j;
+            }
+        }
+    }
+
+    // Make room at the node budget by evicting a leaf
+    if (params_.nodeBudget > 0 && (int)liveNodes >= params_.nodeBudget && freeSlots_.empty()) {
+        if (onBestPath_.size() < tree.size()) onBestPath_.resize(tree.size(), 0);
+        int slot = evictLeaf(tree, children_, onBestPath_, result_.goalIdx, bestParent, rng_);
+        if (slot == -1) return;
+        freeSlots_.push_back(slot);
+    }
+
+    // Add new node to the tree
+    int newIdx;
+    if (!freeSlots_.empty()) {
+        newIdx = freeSlots_.back();
+        freeSlots_.pop_back();
+        tree[newIdx] = {newPt, bestParent, bestCost};
+        children_[newIdx] = 0;
+        length_[newIdx] = bestLength;
+    } else {
+        newIdx = tree.size();
+        tree.push_back({newPt, bestParent, bestCost});
+        children_.push_back(0);
+        length_.push_back(bestLength);
+    }
+    ++children_[bestParent];
+    if (hooks_.onEdge) hooks_.onEdge(tree[bestParent].point, newPt);
+
+    // Rewire nearby nodes if new path is better
+    rewired_.clear();
+    for (int j = 0; j < (int)tree.size(); ++j) {
+        if (j == newIdx || tree[j].parent == EVICTED) continue;
+        float d = dist(tree[j].point, newPt);
+        if (d < radius && bestCost + d < tree[j].cost) {
+            float newCost = bestCost + edgeCost(grid_, newPt, tree[j].point);
+            if (newCost < tree[j].cost && edgeOk(newPt, bestLength, tree[j].point, bestLength + d)) {
+                --children_[tree[j].parent];
+                ++children_[newIdx];
+                rewired_.push_back({j, tree[j].cost - newCost, length_[j] - (bestLength + d)});
+                tree[j].parent = newIdx;
+                tree[j].cost = newCost;
+                length_[j] = bestLength + d;
+            }
+        }
+    }
+    if (!rewired_.empty()) propagateCosts();
+
+    // Check if goal is reached (anytime mode keeps the cheapest goal node and continues)
+    if (dist(newPt, goalPt_) < grid_.cellSize * 0.6f &&
+        (result_.goalIdx == -1 || bestCost < tree[result_.goalIdx].cost)) {
+        result_.goalIdx = newIdx;
+        if (hooks_.onSolution) hooks_.onSolution(extractPath(tree, newIdx), bestCost);
+        if (!params_.anytime) done_ = true;
+    }
+
+    if (hooks_.onIteration) hooks_.onIteration(i);
+}
+
+PlanResult planRRTStar(const OccupancyGrid& grid, int canvasSize, const cv::Point2f& startPt, const cv::Point2f& goalPt,
+                       const PlannerParams& params, std::mt19937& rng, const PlannerHooks& hooks) {
+    RRTStarSearch search(grid, canvasSize, startPt, goalPt, params, rng, hooks);
+    search.step(params.maxIter);
+    return search.finish();
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "distance_field.h"
+#include "hierarchical.h"
+#include "map_deltas.h"
+#include "sample_buffer.h"
+#include "samplers.h"
+#include "steering.h"
+#include <functional>
+
+// Node structure for RRT* tree
+struct Node {
+    cv::Point2f point;
+    int parent;         // -1 for the root, EVICTED for a free slot
+    float cost;
+};
+
+const int EVICTED = -2;     // Parent of a tree slot freed by node-budget eviction
+
+// Tunable RRT* settings
+struct PlannerParams {
+    float stepSize = 50.0f;         // Maximum extension length in pixels
+    int goalBiasPeriod = 5;         // Every n-th sample is the goal
+    int maxIter = 10000;            // Iteration budget
+    float radiusScale = 50.0f;      // Neighbourhood radius = radiusScale * sqrt(log(n) / n)
+    bool anytime = false;           // Keep improving after the first solution until maxIter or shouldStop
+    int nodeBudget = 0;             // Hard node cap (0 = unlimited); leaves off the best path are evicted at the cap
+
+    SteeringMode steering = SteeringMode::Straight;   // Car-like modes use planCarRRTStar()
+    float turningRadius = 20.0f;    // Minimum turning radius in pixels
+    bool compactTree = false;       // Quantized 10-byte nodes (planCompactRRTStar) for very large trees; no nodeBudget
+
+    bool hierarchical = false;      // Restrict sampling to a coarse corridor
+    HierarchicalConfig hier;
+    bool narrowPassage = false;     // Mix in bridge-test and Gaussian samples
+    SamplerConfig sampler;
+    bool clearanceSmoothing = false;  // Optimize the smoothed path for clearance (needs grid.distance; not in car modes)
+    ClearanceConfig clearance;
+};
+
+// Optional callbacks into the planning loop
+struct PlannerHooks {
+    // Extra constraint on a candidate edge, given the tree path length in pixels
+    // from the start to each end (equal to the cost only without a cost map)
+    std::function<bool(const cv::Point2f& from, float fromLength, const cv::Point2f& to, float toLength)> edgeValid;
+    std::function<void(const Corridor&)> onCorridor;                              // Corridor before sampling starts
+    std::function<void(const cv::Point2f& from, const cv::Point2f& to)> onEdge;  // New tree edge
+    std::function<void(int iter)> onIteration;                                   // End of each extended iteration
+    // First or improved solution, with its start-to-goal tree path
+    std::function<void(const std::vector<cv::Point2f>& path, float cost)> onSolution;
+    std::function<bool()> shouldStop;                                            // Polled at every iteration boundary
+};
+
+// Result of one planning query
+struct PlanResult {
+    std::vector<Node> tree;
+    int goalIdx = -1;                   // Cheapest tree node that reached the goal, -1 if none
+    bool stopped = false;               // Ended early through shouldStop
+    std::vector<cv::Point2f> path;      // Start-to-goal tree path
+    std::vector<cv::Point2f> smoothed;  // Shortcut version of path
+
+    bool found() const { return goalIdx != -1; }
+};
+
+// Euclidean distance between two points
+inline float dist(const cv::Point2f& a, const cv::Point2f& b) {
+    return cv::norm(a - b);
+}
+
+// Walk parent links back from a node and return the start-to-node path
+std::vector<cv::Point2f> extractPath(const std::vector<Node>& tree, int goalIdx);
+
+// Smooth a path by greedy shortcutting with collision checks
+std::vector<cv::Point2f> smoothPath(const OccupancyGrid& grid, const std::vector<cv::Point2f>& path);
+
+// Shortcut, then optimize for clearance if params.clearanceSmoothing is set and
+// the grid has a distance field; the final step of every straight-line planner
+std::vector<cv::Point2f> smoothPath(const OccupancyGrid& grid, const std::vector<cv::Point2f>& path,
+                                    const PlannerParams& params);
+
+// Resumable RRT* search: the state of planRRTStar() kept between calls, so a
+// caller can run it in slices and interleave other work or other searches
+class RRTStarSearch {
+public:
+    // grid, rng and the referenced hooks' captures must outlive the search
+    RRTStarSearch(const OccupancyGrid& grid, int canvasSize, const cv::Point2f& startPt, const cv::Point2f& goalPt,
+                  const PlannerParams& params, std::mt19937& rng, const PlannerHooks& hooks = {});
+
+    // Run up to `iterations` iterations; false once the search has finished
+    bool step(int iterations);
+    bool done() const { return done_; }
+    int iterations() const { return iter_; }
+    const PlanResult& partial() const { return result_; }
+
+    // Extract and smooth the path; the search is finished afterwards
+    PlanResult finish();
+
+    // Apply map updates from stream before every iteration; the stream must
+    // update the grid this search was created with
+    void followDeltas(MapDeltaStream* stream) { deltas_ = stream; }
+
+private:
+    bool edgeOk(const cv::Point2f& from, float fromLength, const cv::Point2f& to, float toLength) const;
+    void iterate(int i);
+    void pruneBlocked(const std::vector<CellDelta>& changed);
+    void propagateCosts();
+
+    const OccupancyGrid& grid_;
+    int canvasSize_;
+    cv::Point2f goalPt_;
+    PlannerParams params_;
+    std::mt19937& rng_;
+    PlannerHooks hooks_;
+    SampleBuffer uniform_;
+
+    PlanResult result_;
+    Corridor corridor_;
+    // Child counts identify leaves; free slots are reused once the node budget is reached
+    std::vector<int> children_ = {0}, freeSlots_;
+    std::vector<uint8_t> onBestPath_;
+    MapDeltaStream* deltas_ = nullptr;
+    std::vector<float> length_;                    // Tree path length from the start, per node
+    struct Rewire {
+        int node;
+        float costDrop, lengthDrop;                // lengthDrop may be negative under a cost map
+    };
+    std::vector<Rewire> rewired_;                  // Nodes rewired this iteration
+    std::vector<uint8_t> blocked_, nodeState_;     // Scratch for pruneBlocked() and propagateCosts()
+    std::vector<float> costDrop_, lengthDrop_;
+    std::vector<int> chain_;
+    int iter_ = 0;
+    bool done_ = false;
+};
+
+// Run RRT* from startPt to goalPt (pixel positions) until the goal is reached or maxIter runs out
+PlanResult planRRTStar(const OccupancyGrid& grid, int canvasSize, const cv::Point2f& startPt, const cv::Point2f& goalPt,
+                       const PlannerParams& params, std::mt19937& rng, const PlannerHooks& hooks = {});
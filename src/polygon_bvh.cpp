@@ -0,0 +1,145 @@
+#include "polygon_bvh.h"
+#include <algorithm>
+
+static const int LEAF_SIZE = 4;
+
+// Sign of the turn a -> b -> c
+static float orient(const cv::Point2f& a, const cv::Point2f& b, const cv::Point2f& c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+static bool onSegment(const cv::Point2f& a, const cv::Point2f& b, const cv::Point2f& p) {
+    return std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) && std::min(a.y, b.y) <= p.y && p.y <= std::max(a.y, b.y);
+}
+
+// Exact segment-segment test including touching and collinear overlap
+static bool segmentsIntersect(const cv::Point2f& p1, const cv::Point2f& p2, const cv::Point2f& q1, const cv::Point2f& q2) {
+    float d1 = orient(q1, q2, p1), d2 = orient(q1, q2, p2), d3 = orient(p1, p2, q1), d4 = orient(p1, p2, q2);
+    if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))) return true;
+    return (d1 == 0 && onSegment(q1, q2, p1)) || (d2 == 0 && onSegment(q1, q2, p2)) ||
+           (d3 == 0 && onSegment(p1, p2, q1)) || (d4 == 0 && onSegment(p1, p2, q2));
+}
+
+// Even-odd crossing test; boundary points count as inside
+static bool insidePolygon(const Polygon& poly, const cv::Point2f& pt) {
+    bool inside = false;
+    for (size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++) {
+        const cv::Point2f& a = poly[i];
+        const cv::Point2f& b = poly[j];
+        if (orient(a, b, pt) == 0 && onSegment(a, b, pt)) return true;
+        if ((a.y > pt.y) != (b.y > pt.y) && pt.x < (b.x - a.x) * (pt.y - a.y) / (b.y - a.y) + a.x) inside = !inside;
+    }
+    return inside;
+}
+
+void PolygonBVH::build(const std::vector<Polygon>& polygons) {
+    polygons_.clear();
+    for (auto& poly : polygons)
+        if (poly.size() >= 3) polygons_.push_back(poly);
+
+    bounds_.clear();
+    for (auto& poly : polygons_) {
+        Box box = {poly[0].x, poly[0].y, poly[0].x, poly[0].y};
+        for (auto& p : poly) {
+            box.minX = std::min(box.minX, p.x), box.minY = std::min(box.minY, p.y);
+            box.maxX = std::max(box.maxX, p.x), box.maxY = std::max(box.maxY, p.y);
+        }
+        bounds_.push_back(box);
+    }
+
+    order_.resize(polygons_.size());
+    for (size_t i = 0; i < order_.size(); ++i) order_[i] = (int)i;
+    nodes_.clear();
+    if (!polygons_.empty()) buildNode(0, (int)polygons_.size());
+}
+
+// Median split on the longer axis of the centroid spread
+int PolygonBVH::buildNode(int first, int count) {
+    int idx = nodes_.size();
+    nodes_.emplace_back();
+    Box box = bounds_[order_[first]];
+    float cMinX = 1e30f, cMinY = 1e30f, cMaxX = -1e30f, cMaxY = -1e30f;
+    for (int i = first; i < first + count; ++i) {
+        const Box& b = bounds_[order_[i]];
+        box.minX = std::min(box.minX, b.minX), box.minY = std::min(box.minY, b.minY);
+        box.maxX = std::max(box.maxX, b.maxX), box.maxY = std::max(box.maxY, b.maxY);
+        float cx = (b.minX + b.maxX) / 2, cy = (b.minY + b.maxY) / 2;
+        cMinX = std::min(cMinX, cx), cMinY = std::min(cMinY, cy), cMaxX = std::max(cMaxX, cx), cMaxY = std::max(cMaxY, cy);
+    }
+    nodes_[idx].box = box;
+
+    if (count <= LEAF_SIZE) {
+        nodes_[idx].first = first;
+        nodes_[idx].count = count;
+        return idx;
+    }
+
+    bool splitX = cMaxX - cMinX >= cMaxY - cMinY;
+    auto center = [&](int p) { const Box& b = bounds_[p]; return splitX ? b.minX + b.maxX : b.minY + b.maxY; };
+    int half = count / 2;
+    std::nth_element(order_.begin() + first, order_.begin() + first + half, order_.begin() + first + count,
+                     [&](int a, int b) { return center(a) < center(b); });
+    int left = buildNode(first, half);
+    int right = buildNode(first + half, count - half);
+    nodes_[idx].left = left;
+    nodes_[idx].right = right;
+    return idx;
+}
+
+template <typename BoxTest, typename PolyTest>
+bool PolygonBVH::query(BoxTest boxTest, PolyTest polyTest) const {
+    if (nodes_.empty()) return false;
+    int stack[64], top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const BVHNode& node = nodes_[stack[--top]];
+        if (!boxTest(node.box)) continue;
+        if (node.left == -1) {
+            for (int i = node.first; i < node.first + node.count; ++i)
+                if (boxTest(bounds_[order_[i]]) && polyTest(polygons_[order_[i]])) return true;
+        } else {
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+        }
+    }
+    return false;
+}
+
+size_t PolygonBVH::bytes() const {
+    size_t total = polygons_.capacity() * sizeof(Polygon) + bounds_.capacity() * sizeof(Box) +
+                   order_.capacity() * sizeof(int) + nodes_.capacity() * sizeof(BVHNode);
+    for (const Polygon& poly : polygons_) total += poly.capacity() * sizeof(cv::Point2f);
+    return total;
+}
+
+bool PolygonBVH::contains(const cv::Point2f& pt) const {
+    return query([&](const Box& b) { return pt.x >= b.minX && pt.x <= b.maxX && pt.y >= b.minY && pt.y <= b.maxY; },
+                 [&](const Polygon& poly) { return insidePolygon(poly, pt); });
+}
+
+bool PolygonBVH::intersects(const cv::Point2f& a, const cv::Point2f& b) const {
+    // Slab test of the segment against a box
+    auto segmentHitsBox = [&](const Box& box) {
+        float t0 = 0, t1 = 1;
+        const float o[2] = {a.x, a.y}, d[2] = {b.x - a.x, b.y - a.y};
+        const float lo[2] = {box.minX, box.minY}, hi[2] = {box.maxX, box.maxY};
+        for (int k = 0; k < 2; ++k) {
+            if (d[k] == 0) {
+                if (o[k] < lo[k] || o[k] > hi[k]) return false;
+                continue;
+            }
+            float ta = (lo[k] - o[k]) / d[k], tb = (hi[k] - o[k]) / d[k];
+            if (ta > tb) std::swap(ta, tb);
+            t0 = std::max(t0, ta), t1 = std::min(t1, tb);
+            if (t0 > t1) return false;
+        }
+        return true;
+    };
+    auto segmentHitsPolygon = [&](const Polygon& poly) {
+        if (insidePolygon(poly, a)) return true;
+        for (size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++)
+            if (segmentsIntersect(a, b, poly[j], poly[i])) return true;
+        return false;
+    };
+    return query(segmentHitsBox, segmentHitsPolygon);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// Simple (non-self-intersecting) polygon obstacle in pixel coordinates
+using Polygon = std::vector<cv::Point2f>;
+
+// Bounding-volume hierarchy over polygon obstacles with exact point and
+// segment queries, independent of the grid resolution
+class PolygonBVH {
+public:
+    void build(const std::vector<Polygon>& polygons);
+    bool empty() const { return polygons_.empty(); }
+    const std::vector<Polygon>& polygons() const { return polygons_; }
+    size_t bytes() const;   // Heap storage of the polygons and the hierarchy
+
+    // True if the point lies inside (or on the boundary of) any polygon
+    bool contains(const cv::Point2f& pt) const;
+
+    // True if segment a-b touches any polygon
+    bool intersects(const cv::Point2f& a, const cv::Point2f& b) const;
+
+private:
+    struct Box {
+        float minX, minY, maxX, maxY;
+    };
+    struct BVHNode {
+        Box box;
+        int left = -1, right = -1;      // Children; -1 for leaves
+        int first = 0, count = 0;       // Range in order_ for leaves
+    };
+
+    int buildNode(int first, int count);
+    template <typename BoxTest, typename PolyTest>
+    bool query(BoxTest boxTest, PolyTest polyTest) const;
+
+    std::vector<Polygon> polygons_;
+    std::vector<Box> bounds_;           // Per polygon
+    std::vector<int> order_;            // Polygon indices grouped by leaf
+    std::vector<BVHNode> nodes_;
+};
@@ -0,0 +1,82 @@
+// Planning service front end: forks a pool of planner workers over one map
+// and answers queries read from stdin, one "startX startY goalX goalY" line
+// (grid coordinates) per query. With --publish NAME every result is also
+// published to a shared-memory ring for a controller process.
+#include <opencv2/opencv.hpp>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+#include "map_io.h"
+#include "mapped_grid.h"
+#include "profile.h"
+#include "result_ring.h"
+#include "worker_pool.h"
+
+const int canvasSize = 500;     // Same canvas the editor plans on
+
+int main(int argc, char** argv) {
+    std::string mapPath, publishName;
+    int workers = 4;
+    PlannerParams params;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--workers") && i + 1 < argc) workers = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--profile") && i + 1 < argc) loadProfile(argv[++i], params);
+        else if (!std::strcmp(argv[i], "--publish") && i + 1 < argc) publishName = argv[++i];
+        else mapPath = argv[i];
+    }
+    MapFile map;
+    if (mapPath.empty() || !loadMap(mapPath, map, canvasSize)) {
+        std::cout << "Usage: RRTPool [--workers N] [--profile FILE] [--publish SHM_NAME] map < queries\n";
+        return 1;
+    }
+
+    // Workers share the map through a read-only mapping of its binary form
+    int cellSize = canvasSize / map.gridSize;
+    std::string occPath = mapPath + ".occ";
+    if (!writeOccupancyFile(occPath, buildOccupancyGrid(map.obstacles, map.gridSize, cellSize))) {
+        std::cout << "Cannot write " << occPath << "\n";
+        return 1;
+    }
+    MapOverlays overlays;
+    overlays.build(map, cellSize);
+    ResultRingWriter results;
+    if (!publishName.empty() && !results.create(publishName)) return 1;
+
+    WorkerPool pool(occPath, canvasSize, params, workers, &overlays);
+    if (!pool.start()) return 1;
+
+    std::vector<PlanQuery> queries;
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        std::istringstream fields(line);
+        int sx, sy, gx, gy;
+        if (!(fields >> sx >> sy >> gx >> gy)) continue;
+        queries.push_back({queries.size(), sx * cellSize + cellSize / 2.0f, sy * cellSize + cellSize / 2.0f,
+                           gx * cellSize + cellSize / 2.0f, gy * cellSize + cellSize / 2.0f, (uint32_t)queries.size()});
+    }
+
+    // Keep the query ring fed while draining replies
+    size_t submitted = 0, answered = 0;
+    PlanReply reply;
+    while (answered < queries.size()) {
+        while (submitted < queries.size() && pool.submit(queries[submitted])) ++submitted;
+        if (!pool.poll(reply)) {
+            usleep(100);
+            continue;
+        }
+        ++answered;
+        const char* status = reply.status == ReplyStatus::Found ? "found"
+                           : reply.status == ReplyStatus::NotFound ? "not-found" : "crashed";
+        std::cout << reply.id << " " << status << " " << reply.cost << " " << reply.numPoints << "\n";
+        if (!publishName.empty()) {
+            std::vector<cv::Point2f> path;
+            for (int i = 0; i < reply.numPoints; ++i) path.push_back(cv::Point2f(reply.points[i][0], reply.points[i][1]));
+            ResultStatus outcome = reply.status == ReplyStatus::Found ? ResultStatus::Found
+                                 : reply.status == ReplyStatus::NotFound ? ResultStatus::NotFound : ResultStatus::Failed;
+            results.publish(reply.id, true, reply.cost, path, outcome);
+        }
+    }
+    pool.shutdown();
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "profile.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+bool loadProfile(const std::string& path, PlannerParams& params) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cout << "Cannot open profile " << path << "\n";
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t eq = line.find('=');
+        if (line.empty() || line[0] == '#' || eq == std::string::npos) continue;
+        std::string key, value;
+        std::istringstream(line.substr(0, eq)) >> key;
+        std::istringstream(line.substr(eq + 1)) >> value;
+
+        std::istringstream v(value);
+        if (key == "stepSize") v >> params.stepSize;
+        else if (key == "goalBiasPeriod") v >> params.goalBiasPeriod;
+        else if (key == "maxIter") v >> params.maxIter;
+        else if (key == "radiusScale") v >> params.radiusScale;
+        else if (key == "anytime") v >> params.anytime;
+        else if (key == "nodeBudget") {
+            // The root alone cannot be evicted, so a budget needs room for at least one more node
+            int budget = 0;
+            v >> budget;
+            if (budget == 0 || budget >= 2) params.nodeBudget = budget;
+            else std::cout << "Ignoring nodeBudget " << budget << ", it must be 0 (unlimited) or at least 2\n";
+        }
+        else if (key == "steering") { int mode = 0; v >> mode; params.steering = (SteeringMode)std::clamp(mode, 0, 2); }
+        else if (key == "turningRadius") v >> params.turningRadius;
+        else if (key == "compactTree") v >> params.compactTree;
+        else if (key == "hierarchical") v >> params.hierarchical;
+        else if (key == "coarseFactor") v >> params.hier.coarseFactor;
+        else if (key == "corridorDilation") v >> params.hier.dilation;
+        else if (key == "globalRatio") v >> params.hier.globalRatio;
+        else if (key == "narrowPassage") v >> params.narrowPassage;
+        else if (key == "bridgeRatio") v >> params.sampler.bridgeRatio;
+        else if (key == "gaussianRatio") v >> params.sampler.gaussianRatio;
+        else if (key == "sigma") v >> params.sampler.sigma;
+        else if (key == "clearanceSmoothing") v >> params.clearanceSmoothing;
+        else if (key == "clearance") v >> params.clearance.clearance;
+        else if (key == "clearanceIterations") v >> params.clearance.iterations;
+        else std::cout << "Ignoring unknown profile key " << key << "\n";
+    }
+    params.goalBiasPeriod = std::max(1, params.goalBiasPeriod);
+    if (params.compactTree && params.nodeBudget != 0) {
+        std::cout << "nodeBudget is not supported with compactTree, ignoring it\n";
+        params.nodeBudget = 0;
+    }
+    if (params.steering != SteeringMode::Straight && params.clearanceSmoothing) {
+        std::cout << "clearanceSmoothing is not supported with car-like steering, ignoring it\n";
+        params.clearanceSmoothing = false;
+    }
+    return true;
+}
+
+bool saveProfile(const std::string& path, const PlannerParams& params, const std::string& header) {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    std::istringstream lines(header);
+    for (std::string line; std::getline(lines, line);)
+        out << "# " << line << "\n";
+    out << "stepSize = " << params.stepSize << "\n"
+        << "goalBiasPeriod = " << params.goalBiasPeriod << "\n"
+        << "maxIter = " << params.maxIter << "\n"
+        << "radiusScale = " << params.radiusScale << "\n"
+        << "anytime = " << params.anytime << "\n"
+        << "nodeBudget = " << params.nodeBudget << "\n"
+        << "steering = " << (int)params.steering << "\n"
+        << "turningRadius = " << params.turningRadius << "\n"
+        << "compactTree = " << params.compactTree << "\n"
+        << "hierarchical = " << params.hierarchical << "\n"
+        << "coarseFactor = " << params.hier.coarseFactor << "\n"
+        << "corridorDilation = " << params.hier.dilation << "\n"
+        << "globalRatio = " << params.hier.globalRatio << "\n"
+        << "narrowPassage = " << params.narrowPassage << "\n"
+        << "bridgeRatio = " << params.sampler.bridgeRatio << "\n"
+        << "gaussianRatio = " << params.sampler.gaussianRatio << "\n"
+        << "sigma = " << params.sampler.sigma << "\n"
+        << "clearanceSmoothing = " << params.clearanceSmoothing << "\n"
+        << "clearance = " << params.clearance.clearance << "\n"
+        << "clearanceIterations = " << params.clearance.iterations << "\n";
+    return (bool)out;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "planner.h"
+#include <string>
+
+// Planner profile: "key = value" lines for the PlannerParams fields, '#' comments.
+// Keys missing from the file keep their current value.
+bool loadProfile(const std::string& path, PlannerParams& params);
+
+// Writes all tunables; header lines are written as comments
+bool saveProfile(const std::string& path, const PlannerParams& params, const std::string& header = "");
@@ -0,0 +1,155 @@
+#include "realtime.h"
+#include <algorithm>
+
+RealTimePlanner::RealTimePlanner(const OccupancyGrid& grid, int canvasSize, const PlannerParams& params,
+                                 int capacity, int bucketsPerSide, int bucketCapacity, int maxNeighbors)
+    : grid_(grid), canvasSize_(canvasSize), params_(params), capacity_(capacity),
+      bucketsPerSide_(bucketsPerSide), bucketCapacity_(bucketCapacity), maxNeighbors_(maxNeighbors),
+      bucketPx_((float)canvasSize / bucketsPerSide),
+      nodes_(capacity), bucketNodes_((size_t)bucketsPerSide * bucketsPerSide * bucketCapacity),
+      bucketCount_((size_t)bucketsPerSide * bucketsPerSide), neighbors_(maxNeighbors) {}
+
+void RealTimePlanner::reset(const cv::Point2f& startPt, const cv::Point2f& goalPt, uint32_t seed) {
+    std::fill(bucketCount_.begin(), bucketCount_.end(), 0);
+    count_ = 0;
+    goalPt_ = goalPt;
+    goalIdx_ = -1;
+    iter_ = 0;
+    rng_.seed(seed);
+    uniform_.reset(drawSeed(rng_), 0, (float)(canvasSize_ - 1));
+    insert(startPt, -1, 0);
+}
+
+int RealTimePlanner::bucketOf(const cv::Point2f& pt) const {
+    int bx = std::clamp((int)(pt.x / bucketPx_), 0, bucketsPerSide_ - 1);
+    int by = std::clamp((int)(pt.y / bucketPx_), 0, bucketsPerSide_ - 1);
+    return by * bucketsPerSide_ + bx;
+}
+
+// A full bucket rejects the node, which caps the per-bucket scan cost
+bool RealTimePlanner::insert(const cv::Point2f& pt, int parent, float cost) {
+    int b = bucketOf(pt);
+    if (count_ == capacity_ || bucketCount_[b] == bucketCapacity_) return false;
+    nodes_[count_] = {pt, parent, cost};
+    bucketNodes_[b * bucketCapacity_ + bucketCount_[b]++] = count_++;
+    return true;
+}
+
+// Ring search over buckets, stopping once the next ring cannot hold a closer node
+int RealTimePlanner::nearest(const cv::Point2f& pt) const {
+    int bx = bucketOf(pt) % bucketsPerSide_, by = bucketOf(pt) / bucketsPerSide_;
+    int best = -1;
+    float bestDist = 1e9f;
+    for (int ring = 0; ring < bucketsPerSide_; ++ring) {
+        if (best != -1 && (ring - 1) * bucketPx_ > bestDist) break;
+        for (int y = by - ring; y <= by + ring; ++y) {
+            for (int x = bx - ring; x <= bx + ring; ++x) {
+                if (x < 0 || y < 0 || x >= bucketsPerSide_ || y >= bucketsPerSide_) continue;
+                if (std::max(std::abs(x - bx), std::abs(y - by)) != ring) continue;
+                int b = y * bucketsPerSide_ + x;
+                for (int k = 0; k < bucketCount_[b]; ++k) {
+                    int j = bucketNodes_[b * bucketCapacity_ + k];
+                    float d = dist(nodes_[j].point, pt);
+                    if (d < bestDist) bestDist = d, best = j;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+bool RealTimePlanner::iterate() {
+    int i = iter_++;
+
+    cv::Point2f randPt;
+    if (i % params_.goalBiasPeriod == 0) {
+        randPt = goalPt_;
+    } else if (!params_.narrowPassage || !sampleNarrowPassage(grid_, params_.sampler, rng_, canvasSize_, randPt)) {
+        randPt = uniform_.next();
+    }
+    if (isObstacle(grid_, randPt)) return false;
+
+    int near = nearest(randPt);
+    float d = dist(nodes_[near].point, randPt);
+    if (d == 0) return false;
+    cv::Point2f newPt = nodes_[near].point + (randPt - nodes_[near].point) * (std::min(params_.stepSize, d) / d);
+    if (isObstacle(grid_, newPt) || !collisionFree(grid_, nodes_[near].point, newPt)) return false;
+
+    // Gather at most maxNeighbors nodes within the radius from the buckets it overlaps
+    float radius = params_.radiusScale * std::sqrt(std::log(count_ + 1.0f) / (count_ + 1.0f));
+    int numNeighbors = 0;
+    int x0 = std::max(0, (int)((newPt.x - radius) / bucketPx_)), x1 = std::min(bucketsPerSide_ - 1, (int)((newPt.x + radius) / bucketPx_));
+    int y0 = std::max(0, (int)((newPt.y - radius) / bucketPx_)), y1 = std::min(bucketsPerSide_ - 1, (int)((newPt.y + radius) / bucketPx_));
+    for (int y = y0; y <= y1 && numNeighbors < maxNeighbors_; ++y)
+        for (int x = x0; x <= x1 && numNeighbors < maxNeighbors_; ++x) {
+            int b = y * bucketsPerSide_ + x;
+            for (int k = 0; k < bucketCount_[b] && numNeighbors < maxNeighbors_; ++k) {
+                int j = bucketNodes_[b * bucketCapacity_ + k];
+                if (dist(nodes_[j].point, newPt) < radius) neighbors_[numNeighbors++] = j;
+            }
+        }
+
+    // Choose best parent
+    int bestParent = near;
+    float bestCost = nodes_[near].cost + edgeCost(grid_, nodes_[near].point, newPt);
+    for (int k = 0; k < numNeighbors; ++k) {
+        int j = neighbors_[k];
+        // Edge cost is never below the length, so the length rules out most candidates cheaply
+        if (nodes_[j].cost + dist(nodes_[j].point, newPt) >= bestCost) continue;
+        float cost = nodes_[j].cost + edgeCost(grid_, nodes_[j].point, newPt);
+        if (cost < bestCost && collisionFree(grid_, nodes_[j].point, newPt)) bestCost = cost, bestParent = j;
+    }
+
+    int newIdx = count_;
+    if (!insert(newPt, bestParent, bestCost)) return false;
+
+    // Rewire
+    for (int k = 0; k < numNeighbors; ++k) {
+        int j = neighbors_[k];
+        if (bestCost + dist(newPt, nodes_[j].point) >= nodes_[j].cost) continue;
+        float newCost = bestCost + edgeCost(grid_, newPt, nodes_[j].point);
+        if (newCost < nodes_[j].cost && collisionFree(grid_, newPt, nodes_[j].point)) {
+            nodes_[j].parent = newIdx;
+            nodes_[j].cost = newCost;
+        }
+    }
+
+    // Keep the cheapest node inside the goal region
+    if (dist(newPt, goalPt_) < grid_.cellSize * 0.6f && (goalIdx_ == -1 || bestCost < nodes_[goalIdx_].cost))
+        goalIdx_ = newIdx;
+    return true;
+}
+
+int RealTimePlanner::step(int n) {
+    int done = 0;
+    for (; done < n && !full(); ++done) iterate();
+    return done;
+}
+
+int RealTimePlanner::runFor(std::chrono::microseconds budget) {
+    auto deadline = std::chrono::steady_clock::now() + budget;
+    int done = 0;
+    while (!full() && std::chrono::steady_clock::now() < deadline) {
+        iterate();
+        ++done;
+    }
+    return done;
+}
+
+float RealTimePlanner::bestCost() const {
+    float cost = 0;
+    if (goalIdx_ == -1) return cost;
+    for (int cur = goalIdx_; nodes_[cur].parent != -1; cur = nodes_[cur].parent)
+        cost += edgeCost(grid_, nodes_[nodes_[cur].parent].point, nodes_[cur].point);
+    return cost;
+}
+
+int RealTimePlanner::pathInto(cv::Point2f* out, int maxLen) const {
+    if (goalIdx_ == -1) return 0;
+    int len = 0;
+    for (int cur = goalIdx_; cur != -1; cur = nodes_[cur].parent) ++len;
+    if (len > maxLen) return 0;
+    int k = len;
+    for (int cur = goalIdx_; cur != -1; cur = nodes_[cur].parent) out[--k] = nodes_[cur].point;
+    return len;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "planner.h"
+#include "sample_buffer.h"
+#include <chrono>
+
+// Anytime RRT* for control loops. All storage is sized in the constructor;
+// reset(), step() and runFor() never allocate, print or draw, and each
+// iteration costs at most a fixed number of distance evaluations and edge
+// checks (bounded by the bucket grid, bucket capacity and maxNeighbors).
+// Corridor sampling is not supported here since it allocates per query.
+class RealTimePlanner {
+public:
+    RealTimePlanner(const OccupancyGrid& grid, int canvasSize, const PlannerParams& params,
+                    int capacity, int bucketsPerSide = 32, int bucketCapacity = 16, int maxNeighbors = 32);
+
+    // Starts a new query, keeping all buffers
+    void reset(const cv::Point2f& startPt, const cv::Point2f& goalPt, uint32_t seed);
+
+    // Runs exactly n iterations (fewer once the tree is full); returns iterations run
+    int step(int n);
+
+    // Runs iterations until the time budget is spent; overshoots by at most one iteration
+    int runFor(std::chrono::microseconds budget);
+
+    bool found() const { return goalIdx_ != -1; }
+    // Cost of the current best path (its length without a cost map); rewiring
+    // upstream lowers it without touching stored costs
+    float bestCost() const;
+    int size() const { return count_; }
+    bool full() const { return count_ == capacity_; }
+
+    // Copies the best start-to-goal path into out and returns its length (0 if none or longer than maxLen)
+    int pathInto(cv::Point2f* out, int maxLen) const;
+
+private:
+    bool iterate();
+    int bucketOf(const cv::Point2f& pt) const;
+    int nearest(const cv::Point2f& pt) const;
+    bool insert(const cv::Point2f& pt, int parent, float cost);
+
+    const OccupancyGrid& grid_;
+    int canvasSize_;
+    PlannerParams params_;
+    int capacity_, bucketsPerSide_, bucketCapacity_, maxNeighbors_;
+    float bucketPx_;
+
+    std::vector<Node> nodes_;           // capacity_ slots, count_ in use
+    std::vector<int> bucketNodes_;      // bucketCapacity_ node slots per bucket
+    std::vector<int> bucketCount_;
+    std::vector<int> neighbors_;        // Scratch for choose-parent/rewire
+    int count_ = 0;
+
+    cv::Point2f goalPt_;
+    int goalIdx_ = -1;
+    int iter_ = 0;
+    std::mt19937 rng_;
+    SampleBuffer uniform_;
+};
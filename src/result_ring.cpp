@@ -0,0 +1,109 @@
+#include "result_ring.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Process-shared atomics must be lock-free");
+
+ResultRingWriter::~ResultRingWriter() {
+    close();
+}
+
+bool ResultRingWriter::create(const std::string& name) {
+    close();
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 || ftruncate(fd, sizeof(ResultRingShared)) != 0) {
+        std::cout << "Cannot create shared memory " << name << "\n";
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+    void* mem = mmap(nullptr, sizeof(ResultRingShared), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mem == MAP_FAILED) return false;
+
+    // Readers check the magic, so it is written last
+    shared_ = static_cast<ResultRingShared*>(mem);
+    for (auto& slot : shared_->slots) slot.seq.store(0, std::memory_order_relaxed);
+    shared_->published.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(shared_->magic, "RES2", 4);
+    name_ = name;
+    return true;
+}
+
+void ResultRingWriter::close() {
+    if (!shared_) return;
+    munmap(shared_, sizeof(ResultRingShared));
+    shm_unlink(name_.c_str());
+    shared_ = nullptr;
+}
+
+uint64_t ResultRingWriter::publish(uint64_t queryId, bool final, float cost, const std::vector<cv::Point2f>& path,
+                                   ResultStatus status) {
+    uint64_t n = shared_->published.load(std::memory_order_relaxed);
+    ResultSlot& slot = shared_->slots[n % RESULT_SLOTS];
+
+    // Odd sequence marks the slot as being written; the fence keeps the data
+    // stores from moving above it
+    slot.seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.queryId = queryId;
+    slot.isFinal = final ? 1 : 0;
+    slot.status = status;
+    slot.cost = cost;
+    slot.numPoints = std::min((int)path.size(), MAX_RESULT_POINTS);
+    for (int i = 0; i < slot.numPoints; ++i) {
+        slot.points[i][0] = path[i].x;
+        slot.points[i][1] = path[i].y;
+    }
+    slot.seq.store(2 * n + 2, std::memory_order_release);
+    shared_->published.store(n + 1, std::memory_order_release);
+    return n;
+}
+
+std::function<void(const std::vector<cv::Point2f>&, float)> ResultRingWriter::progressHook(uint64_t queryId) {
+    return [this, queryId](const std::vector<cv::Point2f>& path, float cost) { publish(queryId, false, cost, path); };
+}
+
+ResultRingReader::~ResultRingReader() {
+    close();
+}
+
+bool ResultRingReader::open(const std::string& name) {
+    close();
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        std::cout << "Cannot open shared memory " << name << "\n";
+        return false;
+    }
+    void* mem = mmap(nullptr, sizeof(ResultRingShared), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mem == MAP_FAILED) return false;
+    shared_ = static_cast<ResultRingShared*>(mem);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (std::memcmp(shared_->magic, "RES2", 4) != 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ResultRingReader::close() {
+    if (!shared_) return;
+    munmap(const_cast<ResultRingShared*>(shared_), sizeof(ResultRingShared));
+    shared_ = nullptr;
+}
+
+const ResultSlot* ResultRingReader::peek(uint64_t n) const {
+    const ResultSlot& slot = shared_->slots[n % RESULT_SLOTS];
+    return slot.seq.load(std::memory_order_acquire) == 2 * n + 2 ? &slot : nullptr;
+}
+
+bool ResultRingReader::intact(const ResultSlot* slot, uint64_t n) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot->seq.load(std::memory_order_relaxed) == 2 * n + 2;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+const int RESULT_SLOTS = 64;            // Messages kept before the oldest is overwritten
+const int MAX_RESULT_POINTS = 256;      // Longest path a message can carry
+
+// Outcome carried by a message. Best-so-far updates are always Found; a final
+// message is NotFound or Failed (worker crashed) with no points when the query
+// produced no path, so a consumer can tell "done, no path" from "done, here it is".
+enum class ResultStatus : int32_t { Found, NotFound, Failed };
+
+// One published path. seq is a per-slot seqlock: 2n + 1 while message n is
+// being written, 2n + 2 once it is complete.
+struct ResultSlot {
+    std::atomic<uint64_t> seq;
+    uint64_t queryId;
+    int32_t isFinal;                    // 0 = best-so-far update, 1 = final result
+    ResultStatus status;
+    float cost;
+    int32_t numPoints;
+    float points[MAX_RESULT_POINTS][2];
+};
+
+// Layout of the POSIX shared memory object
+struct ResultRingShared {
+    char magic[4];                      // "RES2"
+    std::atomic<uint64_t> published;    // Messages written so far; message n lives in slot n % RESULT_SLOTS
+    ResultSlot slots[RESULT_SLOTS];
+};
+
+// Single-producer side: the planner process creates the object and publishes
+// paths into it without locks or system calls. The writer never waits for
+// readers; a reader that falls more than RESULT_SLOTS behind loses messages.
+class ResultRingWriter {
+public:
+    ResultRingWriter() = default;
+    ~ResultRingWriter();
+    ResultRingWriter(const ResultRingWriter&) = delete;
+    ResultRingWriter& operator=(const ResultRingWriter&) = delete;
+
+    // name is a shm name such as "/rrt_results"; an existing object is replaced
+    bool create(const std::string& name);
+    void close();
+
+    // Returns the message number; paths longer than MAX_RESULT_POINTS are cut off
+    uint64_t publish(uint64_t queryId, bool final, float cost, const std::vector<cv::Point2f>& path,
+                     ResultStatus status = ResultStatus::Found);
+
+    // PlannerHooks::onSolution that publishes every best-so-far path of a query
+    std::function<void(const std::vector<cv::Point2f>&, float)> progressHook(uint64_t queryId);
+
+private:
+    std::string name_;
+    ResultRingShared* shared_ = nullptr;
+};
+
+// Consumer side (e.g. the motion controller). Messages are read in place in
+// the shared mapping; check intact() after using a slot, since the writer
+// may have reused it meanwhile.
+class ResultRingReader {
+public:
+    ResultRingReader() = default;
+    ~ResultRingReader();
+    ResultRingReader(const ResultRingReader&) = delete;
+    ResultRingReader& operator=(const ResultRingReader&) = delete;
+
+    bool open(const std::string& name);
+    void close();
+
+    uint64_t published() const { return shared_->published.load(std::memory_order_acquire); }
+
+    // Message n if it is complete and still in its slot, otherwise nullptr
+    const ResultSlot* peek(uint64_t n) const;
+
+    // True if message n was not overwritten while the caller was reading it
+    bool intact(const ResultSlot* slot, uint64_t n) const;
+
+private:
+    ResultRingShared* shared_ = nullptr;
+};
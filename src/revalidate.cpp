@@ -0,0 +1,38 @@
+#include "revalidate.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+// First blocked segment of a path, or -1 if all of it is free
+static int firstBlockedSegment(const OccupancyGrid& map, const std::vector<cv::Point2f>& path) {
+    if (path.size() == 1 && isObstacle(map, path[0])) return 0;
+    for (size_t i = 1; i < path.size(); ++i)
+        if (!traversalFree(map, path[i - 1], path[i])) return (int)i - 1;
+    return -1;
+}
+
+std::vector<PathStatus> revalidatePaths(const OccupancyGrid& map, const std::vector<std::vector<cv::Point2f>>& paths,
+                                        int threads) {
+    std::vector<PathStatus> status(paths.size());
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t chunk = 64;
+    threads = (int)std::min<size_t>(threads, (paths.size() + chunk - 1) / chunk);
+
+    // Workers claim fixed-size chunks so long paths do not leave threads idle
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        for (size_t begin; (begin = next.fetch_add(chunk)) < paths.size();) {
+            size_t end = std::min(begin + chunk, paths.size());
+            for (size_t p = begin; p < end; ++p) {
+                status[p].blockedSegment = firstBlockedSegment(map, paths[p]);
+                status[p].valid = status[p].blockedSegment == -1;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(work);
+    work();
+    for (auto& t : pool) t.join();
+    return status;
+}
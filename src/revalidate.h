@@ -0,0 +1,14 @@
+#pragma once
+
+#include "occupancy_grid.h"
+
+// Validity of one stored path against a map snapshot
+struct PathStatus {
+    bool valid = true;
+    int blockedSegment = -1;    // Index i of the first blocked segment path[i] -> path[i + 1]
+};
+
+// Checks every segment of every path with exact cell traversal, spread over
+// worker threads (0 = hardware concurrency). Results are in input order.
+std::vector<PathStatus> revalidatePaths(const OccupancyGrid& map, const std::vector<std::vector<cv::Point2f>>& paths,
+                                        int threads = 0);
@@ -0,0 +1,44 @@
+#include "sample_buffer.h"
+
+// splitmix64, used to spread one seed over all lane states
+static uint64_t splitMix(uint64_t& x) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+void SampleBuffer::reset(uint64_t seed, float lo, float hi) {
+    for (int lane = 0; lane < LANES; ++lane) {
+        uint64_t a = splitMix(seed), b = splitMix(seed);
+        state_[0][lane] = (uint32_t)a, state_[1][lane] = (uint32_t)(a >> 32);
+        state_[2][lane] = (uint32_t)b, state_[3][lane] = (uint32_t)(b >> 32) | 1;   // Never all zero
+    }
+    lo_ = lo;
+    scale_ = hi - lo;
+    pos_ = BLOCK;
+}
+
+void SampleBuffer::refill() {
+    uint32_t s0[LANES], s1[LANES], s2[LANES], s3[LANES];
+    for (int l = 0; l < LANES; ++l) s0[l] = state_[0][l], s1[l] = state_[1][l], s2[l] = state_[2][l], s3[l] = state_[3][l];
+
+    // Top 24 bits map exactly onto the float mantissa, giving values in [0, 1)
+    const float unit = 1.0f / 16777216.0f;
+    for (int i = 0; i < 2 * BLOCK; i += LANES) {
+        for (int l = 0; l < LANES; ++l) {
+            uint32_t result = s0[l] + s3[l];
+            uint32_t t = s1[l] << 9;
+            s2[l] ^= s0[l];
+            s3[l] ^= s1[l];
+            s1[l] ^= s2[l];
+            s0[l] ^= s3[l];
+            s2[l] ^= t;
+            s3[l] = (s3[l] << 11) | (s3[l] >> 21);
+            values_[i + l] = lo_ + (float)(result >> 8) * unit * scale_;
+        }
+    }
+
+    for (int l = 0; l < LANES; ++l) state_[0][l] = s0[l], state_[1][l] = s1[l], state_[2][l] = s2[l], state_[3][l] = s3[l];
+    pos_ = 0;
+}
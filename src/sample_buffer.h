@@ -0,0 +1,39 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+
+// Uniform points in [lo, hi)^2 drawn from xoshiro128+ and generated a block at a
+// time. Eight generator lanes are stepped in lockstep with their state stored
+// lane-minor, so the refill loop compiles to SIMD; the sequence depends only on
+// the seed.
+class SampleBuffer {
+public:
+    SampleBuffer(uint64_t seed = 0, float lo = 0, float hi = 1) { reset(seed, lo, hi); }
+
+    void reset(uint64_t seed, float lo, float hi);
+
+    cv::Point2f next() {
+        if (pos_ == BLOCK) refill();
+        cv::Point2f pt(values_[pos_], values_[BLOCK + pos_]);
+        ++pos_;
+        return pt;
+    }
+
+private:
+    static const int LANES = 8;
+    static const int BLOCK = 256;       // Points per refill
+
+    void refill();
+
+    alignas(32) uint32_t state_[4][LANES];
+    alignas(32) float values_[2 * BLOCK];   // x coordinates, then y coordinates
+    float lo_ = 0, scale_ = 1;
+    int pos_ = BLOCK;
+};
+
+// 64-bit seed drawn from a standard engine, for planners that take one
+template <typename Engine>
+uint64_t drawSeed(Engine& rng) {
+    return ((uint64_t)rng() << 32) ^ (uint64_t)rng();
+}
@@ -0,0 +1,45 @@
+#include "samplers.h"
+
+// Uniform point on the canvas and a Gaussian-perturbed partner around it
+static void samplePair(const OccupancyGrid& grid, const SamplerConfig& cfg, std::mt19937& rng, int canvasSize,
+                       cv::Point2f& a, cv::Point2f& b) {
+    std::uniform_real_distribution<float> dis(0, (float)canvasSize);
+    std::normal_distribution<float> offset(0.0f, cfg.sigma > 0 ? cfg.sigma : (float)grid.cellSize);
+    a = cv::Point2f(dis(rng), dis(rng));
+    b = a + cv::Point2f(offset(rng), offset(rng));
+}
+
+bool sampleBridge(const OccupancyGrid& grid, const SamplerConfig& cfg, std::mt19937& rng, int canvasSize, cv::Point2f& out) {
+    for (int k = 0; k < cfg.maxAttempts; ++k) {
+        cv::Point2f a, b;
+        samplePair(grid, cfg, rng, canvasSize, a, b);
+        if (!isObstacle(grid, a) || !isObstacle(grid, b)) continue;
+        cv::Point2f mid = (a + b) * 0.5f;
+        if (!isObstacle(grid, mid)) {
+            out = mid;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool sampleGaussian(const OccupancyGrid& grid, const SamplerConfig& cfg, std::mt19937& rng, int canvasSize, cv::Point2f& out) {
+    for (int k = 0; k < cfg.maxAttempts; ++k) {
+        cv::Point2f a, b;
+        samplePair(grid, cfg, rng, canvasSize, a, b);
+        bool occA = isObstacle(grid, a), occB = isObstacle(grid, b);
+        if (occA == occB) continue;
+        out = occA ? b : a;
+        return true;
+    }
+    return false;
+}
+
+bool sampleNarrowPassage(const OccupancyGrid& grid, const SamplerConfig& cfg, std::mt19937& rng, int canvasSize, cv::Point2f& out) {
+    float u = std::uniform_real_distribution<float>(0.0f, 1.0f)(rng);
+    if (u < cfg.bridgeRatio)
+        return sampleBridge(grid, cfg, rng, canvasSize, out);
+    if (u < cfg.bridgeRatio + cfg.gaussianRatio)
+        return sampleGaussian(grid, cfg, rng, canvasSize, out);
+    return false;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "occupancy_grid.h"
+#include <random>
+
+// Mixing ratios for the narrow-passage samplers; the remainder is left to the base sampler
+struct SamplerConfig {
+    float bridgeRatio = 0.3f;     // Fraction of samples drawn with the bridge test
+    float gaussianRatio = 0.2f;   // Fraction of samples drawn near obstacle boundaries
+    float sigma = 0.0f;           // Std-dev of the second point in pixels (0 = one cell)
+    int maxAttempts = 20;         // Tries before giving up on a narrow-passage sample
+};
+
+// Bridge test: two nearby points that are both occupied, with a free midpoint
+bool sampleBridge(const OccupancyGrid& grid, const SamplerConfig& cfg, std::mt19937& rng, int canvasSize, cv::Point2f& out);
+
+// Gaussian sampler: of two nearby points exactly one is occupied; keep the free one
+bool sampleGaussian(const OccupancyGrid& grid, const SamplerConfig& cfg, std::mt19937& rng, int canvasSize, cv::Point2f& out);
+
+// Pick a narrow-passage sampler according to the configured ratios.
+// Returns false when the base (uniform/corridor) sampler should be used instead.
+bool sampleNarrowPassage(const OccupancyGrid& grid, const SamplerConfig& cfg, std::mt19937& rng, int canvasSize, cv::Point2f& out);
@@ -0,0 +1,108 @@
+#include "scheduler.h"
+#include "counter_rng.h"
+
+EdfScheduler::EdfScheduler(const OccupancyGrid& grid, int canvasSize, const PlannerParams& params, int threads,
+                           std::function<void(PlanOutcome&&)> onDone)
+    : grid_(grid), canvasSize_(canvasSize), params_(params), onDone_(std::move(onDone)),
+      running_(std::max(1, threads)) {
+    for (int slot = 0; slot < (int)running_.size(); ++slot)
+        threads_.emplace_back(&EdfScheduler::workerLoop, this, slot);
+}
+
+EdfScheduler::~EdfScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+        for (auto& r : running_) r.stop = true;
+    }
+    wake_.notify_all();
+    for (auto& t : threads_) t.join();
+}
+
+void EdfScheduler::submit(const PlanRequest& request) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push({request, Clock::now()});
+        ++outstanding_;
+        preemptForLocked(request.deadline);
+    }
+    wake_.notify_one();
+}
+
+// Preempt only if no worker is idle and the victim is less urgent than the arrival
+void EdfScheduler::preemptForLocked(Clock::time_point deadline) {
+    Running* victim = nullptr;
+    for (auto& r : running_) {
+        if (!r.busy) return;
+        if (r.anytime && r.hasSolution && !r.stop && r.deadline > deadline &&
+            (!victim || r.deadline > victim->deadline))
+            victim = &r;
+    }
+    if (victim) victim->stop = true;
+}
+
+void EdfScheduler::drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [&] { return outstanding_ == 0; });
+}
+
+SchedulerStats EdfScheduler::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void EdfScheduler::workerLoop(int slot) {
+    Running& self = running_[slot];
+    for (;;) {
+        Pending job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return shutdown_ || !pending_.empty(); });
+            if (shutdown_) return;
+            job = pending_.top();
+            pending_.pop();
+            self.busy = true;
+            self.anytime = job.request.anytime;
+            self.deadline = job.request.deadline;
+            self.hasSolution = false;
+            self.stop = false;
+        }
+
+        PlannerParams params = params_;
+        params.anytime = job.request.anytime;
+        // A path found by the deadline meets it, even if an anytime search keeps refining until then
+        bool solvedInTime = false;
+        PlannerHooks hooks;
+        hooks.onSolution = [&](const std::vector<cv::Point2f>&, float) {
+            solvedInTime = solvedInTime || Clock::now() <= job.request.deadline;
+            self.hasSolution = true;
+        };
+        hooks.shouldStop = [&] { return self.stop.load(std::memory_order_relaxed) || Clock::now() >= job.request.deadline; };
+
+        std::mt19937 rng = streamEngine(job.request.seed, job.request.id);
+        PlanResult res = planRRTStar(grid_, canvasSize_, job.request.start, job.request.goal, params, rng, hooks);
+
+        PlanOutcome outcome;
+        outcome.id = job.request.id;
+        outcome.found = res.found();
+        outcome.path = std::move(res.smoothed);
+        outcome.cost = res.found() ? res.tree[res.goalIdx].cost : 0;
+        auto now = Clock::now();
+        outcome.preempted = res.stopped && self.stop && now < job.request.deadline;
+        outcome.missedDeadline = !outcome.found || !solvedInTime;
+        outcome.latencyMs = std::chrono::duration<double, std::milli>(now - job.submitted).count();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            self.busy = false;
+            ++stats_.completed;
+            stats_.missed += outcome.missedDeadline;
+            stats_.preempted += outcome.preempted;
+        }
+        if (onDone_) onDone_(std::move(outcome));
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--outstanding_ == 0) idle_.notify_all();
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "planner.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+// A planning request with a latency target
+struct PlanRequest {
+    uint64_t id;
+    cv::Point2f start, goal;
+    Clock::time_point deadline;
+    bool anytime = false;       // Optimization request: may be preempted once it has a solution
+    uint32_t seed = 0;
+};
+
+// Completed request
+struct PlanOutcome {
+    uint64_t id;
+    bool found = false;
+    std::vector<cv::Point2f> path;  // Smoothed best-so-far path
+    float cost = 0;
+    bool preempted = false;         // Stopped early to free a worker for a more urgent request
+    bool missedDeadline = false;    // No path was found by the deadline
+    double latencyMs = 0;           // Submit to completion
+};
+
+struct SchedulerStats {
+    size_t completed = 0, missed = 0, preempted = 0;
+
+    double missRate() const { return completed ? (double)missed / completed : 0.0; }
+};
+
+// Earliest-deadline-first executor over a pool of planner threads. Every
+// request is stopped at its deadline with its best-so-far result; when all
+// workers are busy, a more urgent arrival preempts the running anytime
+// request with the latest deadline that already has a solution.
+class EdfScheduler {
+public:
+    EdfScheduler(const OccupancyGrid& grid, int canvasSize, const PlannerParams& params, int threads,
+                 std::function<void(PlanOutcome&&)> onDone);
+    ~EdfScheduler();
+
+    void submit(const PlanRequest& request);
+
+    // Blocks until every submitted request has completed
+    void drain();
+
+    SchedulerStats stats() const;
+
+private:
+    struct Pending {
+        PlanRequest request;
+        Clock::time_point submitted;
+        bool operator<(const Pending& o) const { return request.deadline > o.request.deadline; }
+    };
+
+    // What a worker is running, for preemption decisions
+    struct Running {
+        bool busy = false;
+        bool anytime = false;
+        Clock::time_point deadline;
+        std::atomic<bool> hasSolution{false};
+        std::atomic<bool> stop{false};
+    };
+
+    void workerLoop(int slot);
+    void preemptForLocked(Clock::time_point deadline);
+
+    const OccupancyGrid& grid_;
+    int canvasSize_;
+    PlannerParams params_;
+    std::function<void(PlanOutcome&&)> onDone_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_, idle_;
+    std::priority_queue<Pending> pending_;
+    std::vector<Running> running_;
+    std::vector<std::thread> threads_;
+    size_t outstanding_ = 0;
+    bool shutdown_ = false;
+    SchedulerStats stats_;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Bounded multi-producer/multi-consumer ring (per-slot sequence numbers) that
+// can live in memory shared between processes. T must be trivially copyable
+// and N a power of two; call init() once before any process uses it.
+template <typename T, size_t N>
+struct ShmRing {
+    static_assert((N & (N - 1)) == 0, "ShmRing capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "ShmRing elements are copied between processes");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Process-shared atomics must be lock-free");
+
+    struct Slot {
+        std::atomic<uint64_t> seq;
+        T value;
+    };
+
+    alignas(64) std::atomic<uint64_t> head;     // Next position to write
+    alignas(64) std::atomic<uint64_t> tail;     // Next position to read
+    alignas(64) Slot slots[N];
+
+    void init() {
+        for (size_t i = 0; i < N; ++i) slots[i].seq.store(i, std::memory_order_relaxed);
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_release);
+    }
+
+    // Returns false if the ring is full
+    bool push(const T& value) {
+        uint64_t pos = head.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[pos & (N - 1)];
+            int64_t diff = (int64_t)slot.seq.load(std::memory_order_acquire) - (int64_t)pos;
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Returns false if the ring is empty
+    bool pop(T& value) {
+        uint64_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots[pos & (N - 1)];
+            int64_t diff = (int64_t)slot.seq.load(std::memory_order_acquire) - (int64_t)(pos + 1);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = slot.value;
+                    slot.seq.store(pos + N, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
@@ -0,0 +1,250 @@
+#include "steering.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <tuple>
+
+static const double PI = 3.14159265358979323846;
+
+static double mod2pi(double a) {
+    double v = std::fmod(a, 2 * PI);
+    return v < 0 ? v + 2 * PI : v;
+}
+
+float CurvePath::length() const {
+    float len = 0;
+    for (int i = 0; i < count; ++i) len += std::abs(lengths[i]);
+    return len;
+}
+
+// Keeps the candidate if it is shorter than the best so far
+static void consider(CurvePath& best, const char* types, double t, double u, double v) {
+    CurvePath cand;
+    cand.count = 3;
+    const double lens[3] = {t, u, v};
+    for (int i = 0; i < 3; ++i) cand.types[i] = types[i], cand.lengths[i] = (float)lens[i];
+    if (best.count == 0 || cand.length() < best.length()) best = cand;
+}
+
+CurvePath dubinsPath(const Pose& a, const Pose& b, float rho) {
+    double dx = b.x - a.x, dy = b.y - a.y;
+    double d = std::sqrt(dx * dx + dy * dy) / rho;
+    double theta = mod2pi(std::atan2(dy, dx));
+    double al = mod2pi(a.theta - theta), be = mod2pi(b.theta - theta);
+    double sa = std::sin(al), sb = std::sin(be), ca = std::cos(al), cb = std::cos(be), cab = std::cos(al - be);
+
+    CurvePath best;
+    double p2 = 2 + d * d - 2 * cab + 2 * d * (sa - sb);
+    if (p2 >= 0) {
+        double tmp = std::atan2(cb - ca, d + sa - sb);
+        consider(best, "LSL", mod2pi(-al + tmp), std::sqrt(p2), mod2pi(be - tmp));
+    }
+    p2 = 2 + d * d - 2 * cab + 2 * d * (sb - sa);
+    if (p2 >= 0) {
+        double tmp = std::atan2(ca - cb, d - sa + sb);
+        consider(best, "RSR", mod2pi(al - tmp), std::sqrt(p2), mod2pi(-be + tmp));
+    }
+    p2 = -2 + d * d + 2 * cab + 2 * d * (sa + sb);
+    if (p2 >= 0) {
+        double p = std::sqrt(p2);
+        double tmp = std::atan2(-ca - cb, d + sa + sb) - std::atan2(-2.0, p);
+        consider(best, "LSR", mod2pi(-al + tmp), p, mod2pi(-be + tmp));
+    }
+    p2 = d * d - 2 + 2 * cab - 2 * d * (sa + sb);
+    if (p2 >= 0) {
+        double p = std::sqrt(p2);
+        double tmp = std::atan2(ca + cb, d - sa - sb) - std::atan2(2.0, p);
+        consider(best, "RSL", mod2pi(al - tmp), p, mod2pi(be - tmp));
+    }
+    double c = (6 - d * d + 2 * cab + 2 * d * (sa - sb)) / 8;
+    if (std::abs(c) <= 1) {
+        double p = mod2pi(2 * PI - std::acos(c));
+        double t = mod2pi(al - std::atan2(ca - cb, d - sa + sb) + p / 2);
+        consider(best, "RLR", t, p, mod2pi(al - be - t + p));
+    }
+    c = (6 - d * d + 2 * cab + 2 * d * (sb - sa)) / 8;
+    if (std::abs(c) <= 1) {
+        double p = mod2pi(2 * PI - std::acos(c));
+        double t = mod2pi(-al - std::atan2(ca - cb, d + sa - sb) + p / 2);
+        consider(best, "LRL", t, p, mod2pi(be - al - t + p));
+    }
+    return best;
+}
+
+// Reeds-Shepp formulas 8.1-8.4 in the start frame (unit radius)
+static void polar(double x, double y, double& r, double& theta) {
+    r = std::sqrt(x * x + y * y);
+    theta = std::atan2(y, x);
+}
+
+static bool LpSpLp(double x, double y, double phi, double& t, double& u, double& v) {
+    polar(x - std::sin(phi), y - 1 + std::cos(phi), u, t);
+    if (t < -1e-9) return false;
+    v = mod2pi(phi - t);
+    return true;
+}
+
+static bool LpSpRp(double x, double y, double phi, double& t, double& u, double& v) {
+    double t1, u1;
+    polar(x + std::sin(phi), y - 1 - std::cos(phi), u1, t1);
+    u1 *= u1;
+    if (u1 < 4) return false;
+    u = std::sqrt(u1 - 4);
+    t = mod2pi(t1 + std::atan2(2.0, u));
+    v = mod2pi(t - phi);
+    return true;
+}
+
+static bool LpRmL(double x, double y, double phi, double& t, double& u, double& v) {
+    double r, theta;
+    polar(x - std::sin(phi), y - 1 + std::cos(phi), r, theta);
+    if (r > 4) return false;
+    u = -2 * std::asin(0.25 * r);
+    t = mod2pi(theta + 0.5 * u + PI);
+    v = mod2pi(phi - t + u);
+    return true;
+}
+
+CurvePath reedsSheppPath(const Pose& a, const Pose& b, float rho) {
+    double dx = b.x - a.x, dy = b.y - a.y, c = std::cos(a.theta), s = std::sin(a.theta);
+    double x = (c * dx + s * dy) / rho, y = (-s * dx + c * dy) / rho, phi = b.theta - a.theta;
+    double t, u, v;
+    CurvePath best;
+
+    // CSC: plain, time-flipped, reflected, and both
+    if (LpSpLp(x, y, phi, t, u, v)) consider(best, "LSL", t, u, v);
+    if (LpSpLp(-x, y, -phi, t, u, v)) consider(best, "LSL", -t, -u, -v);
+    if (LpSpLp(x, -y, -phi, t, u, v)) consider(best, "RSR", t, u, v);
+    if (LpSpLp(-x, -y, phi, t, u, v)) consider(best, "RSR", -t, -u, -v);
+    if (LpSpRp(x, y, phi, t, u, v)) consider(best, "LSR", t, u, v);
+    if (LpSpRp(-x, y, -phi, t, u, v)) consider(best, "LSR", -t, -u, -v);
+    if (LpSpRp(x, -y, -phi, t, u, v)) consider(best, "RSL", t, u, v);
+    if (LpSpRp(-x, -y, phi, t, u, v)) consider(best, "RSL", -t, -u, -v);
+
+    // CCC, forwards and driven backwards from the goal
+    if (LpRmL(x, y, phi, t, u, v)) consider(best, "LRL", t, u, v);
+    if (LpRmL(-x, y, -phi, t, u, v)) consider(best, "LRL", -t, -u, -v);
+    if (LpRmL(x, -y, -phi, t, u, v)) consider(best, "RLR", t, u, v);
+    if (LpRmL(-x, -y, phi, t, u, v)) consider(best, "RLR", -t, -u, -v);
+    double xb = x * std::cos(phi) + y * std::sin(phi), yb = x * std::sin(phi) - y * std::cos(phi);
+    if (LpRmL(xb, yb, phi, t, u, v)) consider(best, "LRL", v, u, t);
+    if (LpRmL(-xb, yb, -phi, t, u, v)) consider(best, "LRL", -v, -u, -t);
+    if (LpRmL(xb, -yb, -phi, t, u, v)) consider(best, "RLR", v, u, t);
+    if (LpRmL(-xb, -yb, phi, t, u, v)) consider(best, "RLR", -v, -u, -t);
+    return best;
+}
+
+CurvePath shortestPath(SteeringMode mode, const Pose& a, const Pose& b, float rho) {
+    if (mode == SteeringMode::ReedsShepp) return reedsSheppPath(a, b, rho);
+    return dubinsPath(a, b, rho);
+}
+
+// Advance a pose along one segment by a signed length (unit radius)
+static void advance(double& x, double& y, double& th, char type, double len) {
+    if (type == 'L') {
+        x += std::sin(th + len) - std::sin(th);
+        y += -std::cos(th + len) + std::cos(th);
+        th += len;
+    } else if (type == 'R') {
+        x += -std::sin(th - len) + std::sin(th);
+        y += std::cos(th - len) - std::cos(th);
+        th -= len;
+    } else {
+        x += len * std::cos(th);
+        y += len * std::sin(th);
+    }
+}
+
+Pose interpolate(const Pose& a, const CurvePath& path, float rho, float s) {
+    double x = 0, y = 0, th = a.theta, remaining = s / rho;
+    for (int i = 0; i < path.count && remaining > 0; ++i) {
+        double len = std::min<double>(std::abs(path.lengths[i]), remaining);
+        advance(x, y, th, path.types[i], path.lengths[i] < 0 ? -len : len);
+        remaining -= len;
+    }
+    return {(float)(a.x + x * rho), (float)(a.y + y * rho), (float)mod2pi(th)};
+}
+
+void samplePath(const Pose& a, const CurvePath& path, float rho, float step, std::vector<Pose>& out) {
+    float total = path.length() * rho;
+    int n = std::max(1, (int)std::ceil(total / step));
+    for (int i = 0; i <= n; ++i) out.push_back(interpolate(a, path, rho, total * i / n));
+}
+
+void SteeringTable::build(SteeringMode mode, float rho, float range, int cellsXY, int cellsTheta) {
+    mode_ = mode;
+    rho_ = rho;
+    range_ = range;
+    cells_ = cellsXY;
+    cellsTheta_ = cellsTheta;
+    margin_ = 0;
+
+    // Exact lengths at the grid vertices: start pose at the origin facing +x
+    int n = cellsXY + 1;
+    std::vector<float> exact((size_t)n * n * cellsTheta);
+    Pose origin = {0, 0, 0};
+    for (int it = 0; it < cellsTheta; ++it)
+        for (int iy = 0; iy < n; ++iy)
+            for (int ix = 0; ix < n; ++ix) {
+                Pose goal = {-range + 2 * range * ix / cellsXY, -range + 2 * range * iy / cellsXY, (float)(2 * PI * it / cellsTheta)};
+                exact[((size_t)it * n + iy) * n + ix] = shortestPath(mode, origin, goal, rho).length() * rho;
+            }
+
+    // Cell bound: minimum over the 6x6x6 vertices around the cell (heading wraps)
+    table_.resize((size_t)cellsXY * cellsXY * cellsTheta);
+    for (int it = 0; it < cellsTheta; ++it)
+        for (int iy = 0; iy < cellsXY; ++iy)
+            for (int ix = 0; ix < cellsXY; ++ix) {
+                float m = std::numeric_limits<float>::max();
+                for (int dt = -2; dt <= 3; ++dt) {
+                    int t = (it + dt + cellsTheta) % cellsTheta;
+                    for (int y = std::max(iy - 2, 0); y <= std::min(iy + 3, n - 1); ++y)
+                        for (int x = std::max(ix - 2, 0); x <= std::min(ix + 3, n - 1); ++x)
+                            m = std::min(m, exact[((size_t)t * n + y) * n + x]);
+                }
+                table_[((size_t)it * cellsXY + iy) * cellsXY + ix] = m;
+            }
+
+    // Measure how far the cell bounds can still exceed exact lengths
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> pos(-range, range), heading(0, 2 * PI);
+    for (int i = 0; i < 20000; ++i) {
+        Pose goal = {pos(rng), pos(rng), heading(rng)};
+        float len = shortestPath(mode, origin, goal, rho).length() * rho;
+        margin_ = std::max(margin_, cellBound(goal.x, goal.y, goal.theta) - len);
+    }
+    margin_ *= 1.5f;
+}
+
+const SteeringTable& cachedSteeringTable(SteeringMode mode, float rho, float range) {
+    static std::mutex mutex;
+    static std::map<std::tuple<int, float, float>, std::unique_ptr<SteeringTable>> tables;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& table = tables[std::make_tuple((int)mode, rho, range)];
+    if (!table) {
+        table = std::make_unique<SteeringTable>();
+        table->build(mode, rho, range);
+    }
+    return *table;
+}
+
+float SteeringTable::cellBound(double x, double y, double theta) const {
+    int ix = std::clamp((int)((x + range_) / (2 * range_) * cells_), 0, cells_ - 1);
+    int iy = std::clamp((int)((y + range_) / (2 * range_) * cells_), 0, cells_ - 1);
+    int it = std::min((int)(mod2pi(theta) / (2 * PI) * cellsTheta_), cellsTheta_ - 1);
+    return table_[((size_t)it * cells_ + iy) * cells_ + ix];
+}
+
+float SteeringTable::lowerBound(const Pose& a, const Pose& b) const {
+    double dx = b.x - a.x, dy = b.y - a.y, c = std::cos(a.theta), s = std::sin(a.theta);
+    double x = c * dx + s * dy, y = -s * dx + c * dy;
+    // Within a turning radius or so the short-path valleys are thinner than a cell
+    double euclid = std::hypot(dx, dy);
+    if (table_.empty() || std::abs(x) >= range_ || std::abs(y) >= range_ || euclid < 1.5 * rho_)
+        return shortestPath(mode_, a, b, rho_).length() * rho_;
+    return std::max((float)euclid, cellBound(x, y, b.theta - a.theta) - margin_);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// How the planner connects two states
+enum class SteeringMode { Straight, Dubins, ReedsShepp };
+
+// Vehicle pose in pixels / radians
+struct Pose {
+    float x, y, theta;
+};
+
+// Path of up to five arc/line segments for a unit turning radius.
+// Lengths are signed: negative segments are driven in reverse (Reeds-Shepp only).
+struct CurvePath {
+    char types[5];      // 'L', 'S' or 'R'
+    float lengths[5];
+    int count = 0;
+
+    // Total length in units of the turning radius
+    float length() const;
+};
+
+// Shortest Dubins path (forward only, all six words)
+CurvePath dubinsPath(const Pose& a, const Pose& b, float rho);
+
+// Shortest Reeds-Shepp path over the CSC and CCC families with all time-flip
+// and reflection variants (the CCCC/CCSC/CCSCC families are not searched, so
+// some manoeuvres come out slightly longer than the true optimum)
+CurvePath reedsSheppPath(const Pose& a, const Pose& b, float rho);
+
+CurvePath shortestPath(SteeringMode mode, const Pose& a, const Pose& b, float rho);
+
+// Pose after travelling s pixels (path length, ignoring direction) along the path
+Pose interpolate(const Pose& a, const CurvePath& path, float rho, float s);
+
+// Poses every step pixels along the path, including both ends
+void samplePath(const Pose& a, const CurvePath& path, float rho, float step, std::vector<Pose>& out);
+
+// Precomputed lower bounds on path length over relative goal poses (x, y,
+// heading change). Curve lengths jump across switching surfaces, so each
+// table cell holds the minimum exact length over its corners and those of
+// its neighbours, minus the worst undershoot measured against exact lengths
+// when the table is built; the Euclidean distance is a floor. Lengths are in
+// pixels; queries outside the table or within 1.5 turning radii fall back to
+// the exact computation.
+class SteeringTable {
+public:
+    void build(SteeringMode mode, float rho, float range, int cellsXY = 64, int cellsTheta = 72);
+    bool empty() const { return table_.empty(); }
+    float lowerBound(const Pose& a, const Pose& b) const;
+
+private:
+    float cellBound(double x, double y, double theta) const;
+
+    SteeringMode mode_ = SteeringMode::Dubins;
+    float rho_ = 1, range_ = 0, margin_ = 0;
+    int cells_ = 0, cellsTheta_ = 0;
+    std::vector<float> table_;      // Per cell, theta-major
+};
+
+// Process-wide table for the given settings, built on first use and then
+// shared by every query (building one takes tens to hundreds of milliseconds)
+const SteeringTable& cachedSteeringTable(SteeringMode mode, float rho, float range);
@@ -0,0 +1,175 @@
+#include "tile_cache.h"
+#include <algorithm>
+
+bool tileOccupied(TileCache* tiles, int r, int c) {
+    return tiles->occupied(r, c);
+}
+
+TileCache::~TileCache() {
+    close();
+}
+
+bool TileCache::open(const std::string& path, size_t capacityTiles) {
+    close();
+    if (!syncReader_.open(path, 1) || !ioReader_.open(path, 1)) return false;
+    tileSize_ = syncReader_.tileSize();
+    tilePx_ = tileSize_ * syncReader_.cellSize();
+    capacity_ = std::max<size_t>(2, capacityTiles);
+    stop_ = false;
+    io_ = std::thread(&TileCache::ioLoop, this);
+    return true;
+}
+
+void TileCache::close() {
+    if (io_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        io_.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.clear();
+    lru_.clear();
+    queue_.clear();
+    queued_.clear();
+    misses_ = prefetched_ = prefetchHits_ = 0;
+    lastIndex_ = -1;
+    lastTile_.reset();
+}
+
+OccupancyGrid TileCache::grid() {
+    OccupancyGrid grid;
+    grid.rows = syncReader_.rows();
+    grid.cols = syncReader_.cols();
+    grid.cellSize = syncReader_.cellSize();
+    grid.tiles = this;
+    return grid;
+}
+
+bool TileCache::occupied(int r, int c) {
+    if (r < 0 || r >= syncReader_.rows() || c < 0 || c >= syncReader_.cols()) return true;
+    int index = (r / tileSize_) * syncReader_.tileCols() + c / tileSize_;
+    const uint8_t* cells = index == lastIndex_ ? lastTile_->data() : lookup(index);
+    return cells[(r % tileSize_) * tileSize_ + c % tileSize_] != 0;
+}
+
+// Resident tile for the planning thread, read synchronously on a miss. The
+// memo holds a reference, so eviction never frees the tile being read.
+const uint8_t* TileCache::lookup(int index) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = cache_.find(index);
+        if (it != cache_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second.lru);
+            if (it->second.prefetched && !it->second.used) ++prefetchHits_;
+            it->second.used = true;
+            lastIndex_ = index;
+            lastTile_ = it->second.cells;
+            return lastTile_->data();
+        }
+    }
+
+    auto cells = std::make_shared<std::vector<uint8_t>>();
+    if (!syncReader_.readTile(index, *cells)) cells->assign((size_t)tileSize_ * tileSize_, 1);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++misses_;
+    if (!cache_.count(index)) insertLocked(index, cells, false);
+    cache_[index].used = true;
+    lastIndex_ = index;
+    lastTile_ = cache_[index].cells;
+    return lastTile_->data();
+}
+
+void TileCache::insertLocked(int index, Tile cells, bool prefetched) {
+    while (cache_.size() >= capacity_) {
+        cache_.erase(lru_.back());
+        lru_.pop_back();
+    }
+    lru_.push_front(index);
+    Entry& entry = cache_[index];
+    entry.cells = std::move(cells);
+    entry.lru = lru_.begin();
+    entry.prefetched = prefetched;
+}
+
+void TileCache::enqueue(int index) {
+    // Caller holds the lock
+    if (cache_.count(index) || !queued_.insert(index).second) return;
+    queue_.push_back(index);
+}
+
+void TileCache::prefetchSegment(const cv::Point2f& a, const cv::Point2f& b, int radius) {
+    int tileRows = syncReader_.tileRows(), tileCols = syncReader_.tileCols();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Nearest tiles first so the start of the query is covered soonest
+        traverseCells(tilePx_, a, b, [&](int tr, int tc, float, float) {
+            for (int dr = -radius; dr <= radius; ++dr)
+                for (int dc = -radius; dc <= radius; ++dc)
+                    if (tr + dr >= 0 && tr + dr < tileRows && tc + dc >= 0 && tc + dc < tileCols)
+                        enqueue((tr + dr) * tileCols + tc + dc);
+            return true;
+        });
+    }
+    wake_.notify_one();
+}
+
+void TileCache::prefetchFrontier(const cv::Point2f& from, const cv::Point2f& to) {
+    // The tile one tile-length ahead of the new node, in the direction it grew
+    cv::Point2f dir = to - from;
+    float len = cv::norm(dir);
+    if (len == 0) return;
+    cv::Point2f ahead = to + dir * (tilePx_ / len);
+    int tr = (int)std::floor(ahead.y / tilePx_), tc = (int)std::floor(ahead.x / tilePx_);
+    if (tr < 0 || tr >= syncReader_.tileRows() || tc < 0 || tc >= syncReader_.tileCols()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        enqueue(tr * syncReader_.tileCols() + tc);
+    }
+    wake_.notify_one();
+}
+
+void TileCache::ioLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+        if (stop_) return;
+        int index = queue_.front();
+        queue_.pop_front();
+        queued_.erase(index);
+        if (cache_.count(index)) continue;
+
+        // Read and decompress without holding the lock
+        lock.unlock();
+        auto cells = std::make_shared<std::vector<uint8_t>>();
+        bool ok = ioReader_.readTile(index, *cells);
+        lock.lock();
+        if (ok && !cache_.count(index)) {
+            insertLocked(index, cells, true);
+            ++prefetched_;
+        }
+    }
+}
+
+size_t TileCache::residentTiles() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_.size();
+}
+
+size_t TileCache::misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+size_t TileCache::prefetched() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return prefetched_;
+}
+
+size_t TileCache::prefetchHits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return prefetchHits_;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "tiled_map.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+// Out-of-core occupancy for maps larger than memory: tiles of a TIL1 file are
+// kept in an LRU cache of bounded size, and a background I/O thread loads the
+// tiles a planner is about to need (along the start-goal line, around the
+// growing tree) so the planning loop rarely waits on a read.
+//
+// occupied() is meant for one planning thread; prefetch requests may come
+// from any thread.
+class TileCache {
+public:
+    TileCache() = default;
+    ~TileCache();
+    TileCache(const TileCache&) = delete;
+    TileCache& operator=(const TileCache&) = delete;
+
+    bool open(const std::string& path, size_t capacityTiles);
+    void close();
+
+    // Grid descriptor whose cell queries go through this cache. It supports
+    // what the RRT* loop uses (isObstacle, collisionFree, traversalFree), not
+    // whole-grid passes such as maxPool or the hierarchical corridor search.
+    OccupancyGrid grid();
+
+    bool occupied(int r, int c);
+
+    // Queue the tiles within `radius` tiles of the segment a-b (pixels)
+    void prefetchSegment(const cv::Point2f& a, const cv::Point2f& b, int radius = 1);
+
+    // Queue the tile the tree is growing into past a new edge; meant for PlannerHooks::onEdge
+    void prefetchFrontier(const cv::Point2f& from, const cv::Point2f& to);
+
+    size_t residentTiles() const;
+    size_t misses() const;              // Tiles the planning thread had to read itself
+    size_t prefetched() const;          // Tiles loaded by the I/O thread
+    size_t prefetchHits() const;        // Prefetched tiles later used by the planning thread
+
+private:
+    using Tile = std::shared_ptr<const std::vector<uint8_t>>;
+    struct Entry {
+        Tile cells;
+        std::list<int>::iterator lru;
+        bool prefetched = false, used = false;
+    };
+
+    const uint8_t* lookup(int index);
+    void insertLocked(int index, Tile cells, bool prefetched);
+    void enqueue(int index);
+    void ioLoop();
+
+    TiledMap syncReader_, ioReader_;    // Separate streams so misses do not wait behind prefetches
+    int tileSize_ = 1, tilePx_ = 1;
+    size_t capacity_ = 0;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<int, Entry> cache_;
+    std::list<int> lru_;                // Most recently used first
+    size_t misses_ = 0, prefetched_ = 0, prefetchHits_ = 0;
+
+    std::condition_variable wake_;
+    std::deque<int> queue_;
+    std::unordered_set<int> queued_;
+    bool stop_ = false;
+    std::thread io_;
+
+    int lastIndex_ = -1;                // One-tile memo for the planning thread
+    Tile lastTile_;
+};
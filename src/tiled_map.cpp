@@ -0,0 +1,160 @@
+#include "tiled_map.h"
+#include <algorithm>
+#include <iostream>
+
+// Run-length encode as (varint run length, value) pairs
+static void encodeRuns(const std::vector<uint8_t>& cells, std::vector<uint8_t>& out) {
+    for (size_t i = 0; i < cells.size();) {
+        size_t j = i;
+        while (j < cells.size() && cells[j] == cells[i]) ++j;
+        for (uint64_t run = j - i; ; run >>= 7) {
+            out.push_back((uint8_t)(run & 0x7f) | (run >= 0x80 ? 0x80 : 0));
+            if (run < 0x80) break;
+        }
+        out.push_back(cells[i]);
+        i = j;
+    }
+}
+
+bool writeTiledMap(const std::string& path, const OccupancyGrid& grid, int tileSize) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+    TiledFileHeader header = {{'T', 'I', 'L', '1'}, grid.rows, grid.cols, grid.cellSize, tileSize};
+    int tileRows = (grid.rows + tileSize - 1) / tileSize, tileCols = (grid.cols + tileSize - 1) / tileSize;
+
+    // Compress every tile first so the index can be written ahead of the data
+    std::vector<TileIndexEntry> index((size_t)tileRows * tileCols);
+    std::vector<uint8_t> data, cells;
+    uint64_t base = sizeof(header) + index.size() * sizeof(TileIndexEntry);
+    for (int tr = 0; tr < tileRows; ++tr) {
+        for (int tc = 0; tc < tileCols; ++tc) {
+            cells.clear();
+            for (int r = tr * tileSize; r < std::min(grid.rows, (tr + 1) * tileSize); ++r)
+                for (int c = tc * tileSize; c < std::min(grid.cols, (tc + 1) * tileSize); ++c)
+                    cells.push_back(grid.data()[r * grid.cols + c]);
+            size_t before = data.size();
+            encodeRuns(cells, data);
+            index[tr * tileCols + tc] = {base + before, (uint32_t)(data.size() - before)};
+        }
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(TileIndexEntry));
+    out.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return (bool)out;
+}
+
+bool TiledMap::open(const std::string& path, size_t cacheTiles) {
+    file_.close();
+    file_.clear();
+    cache_.clear();
+    lru_.clear();
+    loads_ = 0;
+    capacity_ = std::max<size_t>(1, cacheTiles);
+
+    file_.open(path, std::ios::binary);
+    if (!file_ || !file_.read(reinterpret_cast<char*>(&header_), sizeof(header_)) ||
+        std::string(header_.magic, 4) != "TIL1" || header_.tileSize <= 0 || header_.rows <= 0 || header_.cols <= 0) {
+        std::cout << "Cannot open tiled map " << path << "\n";
+        return false;
+    }
+    tileRows_ = (header_.rows + header_.tileSize - 1) / header_.tileSize;
+    tileCols_ = (header_.cols + header_.tileSize - 1) / header_.tileSize;
+    index_.resize((size_t)tileRows_ * tileCols_);
+    if (!file_.read(reinterpret_cast<char*>(index_.data()), index_.size() * sizeof(TileIndexEntry))) return false;
+    file_.seekg(0, std::ios::end);
+    fileBytes_ = (uint64_t)file_.tellg();
+    return (bool)file_;
+}
+
+bool TiledMap::readTile(int index, std::vector<uint8_t>& cells) {
+    int tr = index / tileCols_, tc = index % tileCols_, ts = header_.tileSize;
+    int h = std::min(ts, header_.rows - tr * ts), w = std::min(ts, header_.cols - tc * ts);
+
+    // A bad index entry must not allocate or seek past the file; a failed read
+    // clears the stream so later tiles can still be read
+    const TileIndexEntry& entry = index_[index];
+    if (entry.offset > fileBytes_ || entry.bytes > fileBytes_ - entry.offset) return false;
+    std::vector<uint8_t> packed(entry.bytes);
+    file_.seekg(entry.offset);
+    if (!file_.read(reinterpret_cast<char*>(packed.data()), packed.size())) {
+        file_.clear();
+        return false;
+    }
+
+    // Runs cover the cropped h x w tile row by row; pad to ts x ts with occupied cells
+    cells.assign((size_t)ts * ts, 1);
+    size_t pos = 0, n = (size_t)h * w;
+    for (size_t i = 0; i < packed.size() && pos < n;) {
+        uint64_t run = 0;
+        for (int shift = 0; i < packed.size(); shift += 7) {
+            uint8_t b = packed[i++];
+            run |= (uint64_t)(b & 0x7f) << shift;
+            if (!(b & 0x80)) break;
+        }
+        if (i >= packed.size()) return false;
+        uint8_t value = packed[i++];
+        for (uint64_t k = 0; k < run && pos < n; ++k, ++pos) cells[(pos / w) * ts + pos % w] = value;
+    }
+    return pos == n;
+}
+
+const std::vector<uint8_t>& TiledMap::tile(int tr, int tc) {
+    int index = tr * tileCols_ + tc;
+    auto it = cache_.find(index);
+    if (it != cache_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second.lru);
+        return it->second.cells;
+    }
+
+    if (cache_.size() >= capacity_) {
+        cache_.erase(lru_.back());
+        lru_.pop_back();
+    }
+    CachedTile& entry = cache_[index];
+    if (!readTile(index, entry.cells)) {
+        std::cout << "Corrupt tile " << tr << "," << tc << ", treating it as occupied\n";
+        entry.cells.assign((size_t)header_.tileSize * header_.tileSize, 1);
+    }
+    lru_.push_front(index);
+    entry.lru = lru_.begin();
+    ++loads_;
+    return entry.cells;
+}
+
+bool TiledMap::occupied(int r, int c) {
+    if (r < 0 || r >= header_.rows || c < 0 || c >= header_.cols) return true;
+    int ts = header_.tileSize;
+    return tile(r / ts, c / ts)[(r % ts) * ts + c % ts] != 0;
+}
+
+OccupancyGrid TiledMap::window(int r0, int c0, int rows, int cols) {
+    OccupancyGrid grid;
+    int r1 = std::min(header_.rows, r0 + rows), c1 = std::min(header_.cols, c0 + cols);
+    r0 = std::max(0, r0), c0 = std::max(0, c0);
+    grid.rows = std::max(0, r1 - r0);
+    grid.cols = std::max(0, c1 - c0);
+    grid.cellSize = header_.cellSize;
+    grid.cells.assign((size_t)grid.rows * grid.cols, 0);
+
+    // Copy tile by tile so each one is looked up once
+    int ts = header_.tileSize;
+    for (int tr = r0 / ts; grid.rows && tr <= (r1 - 1) / ts; ++tr) {
+        for (int tc = c0 / ts; grid.cols && tc <= (c1 - 1) / ts; ++tc) {
+            const std::vector<uint8_t>& cells = tile(tr, tc);
+            for (int r = std::max(r0, tr * ts); r < std::min(r1, (tr + 1) * ts); ++r) {
+                int cStart = std::max(c0, tc * ts), cEnd = std::min(c1, (tc + 1) * ts);
+                std::copy(cells.begin() + (r - tr * ts) * ts + (cStart - tc * ts),
+                          cells.begin() + (r - tr * ts) * ts + (cEnd - tc * ts),
+                          grid.cells.begin() + (size_t)(r - r0) * grid.cols + (cStart - c0));
+            }
+        }
+    }
+    return grid;
+}
+
+size_t TiledMap::compressedBytes() const {
+    size_t total = 0;
+    for (auto& entry : index_) total += entry.bytes;
+    return total;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "occupancy_grid.h"
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+// Tiled occupancy file: header, an index with one entry per tile, then each
+// tile's cells run-length encoded (varint run, value byte) so large uniform
+// areas take a few bytes. Tiles at the right/bottom edge are cropped.
+struct TiledFileHeader {
+    char magic[4];      // "TIL1"
+    int32_t rows, cols, cellSize;
+    int32_t tileSize;   // Tile edge in cells
+};
+
+struct TileIndexEntry {
+    uint64_t offset;    // From the start of the file
+    uint32_t bytes;     // Compressed size
+};
+
+bool writeTiledMap(const std::string& path, const OccupancyGrid& grid, int tileSize = 64);
+
+// Reader that decompresses tiles on first access into an LRU cache holding at
+// most cacheTiles tiles, so a query only pays for the tiles it touches.
+class TiledMap {
+public:
+    bool open(const std::string& path, size_t cacheTiles = 64);
+
+    int rows() const { return header_.rows; }
+    int cols() const { return header_.cols; }
+    int cellSize() const { return header_.cellSize; }
+    int tileSize() const { return header_.tileSize; }
+
+    // Cells outside the map count as occupied, like OccupancyGrid
+    bool occupied(int r, int c);
+
+    // Dense grid of the cells in [r0, r0 + rows) x [c0, c0 + cols), clipped to
+    // the map; only the overlapping tiles are decompressed. Its pixel
+    // coordinates start at the window corner (c0 * cellSize, r0 * cellSize).
+    OccupancyGrid window(int r0, int c0, int rows, int cols);
+
+    // Decompress one tile (index = tileRow * tileCols + tileCol) into tileSize^2
+    // cells, padded with occupied cells at the map edges; bypasses the cache.
+    // False for a corrupt tile, after which other tiles still read normally.
+    bool readTile(int index, std::vector<uint8_t>& cells);
+    int tileRows() const { return tileRows_; }
+    int tileCols() const { return tileCols_; }
+
+    size_t residentTiles() const { return cache_.size(); }
+    size_t tileLoads() const { return loads_; }
+    size_t compressedBytes() const;
+
+private:
+    struct CachedTile {
+        std::vector<uint8_t> cells;     // tileSize * tileSize, row-major, padded at map edges
+        std::list<int>::iterator lru;
+    };
+
+    const std::vector<uint8_t>& tile(int tr, int tc);
+
+    std::ifstream file_;
+    TiledFileHeader header_ = {};
+    int tileRows_ = 0, tileCols_ = 0;
+    std::vector<TileIndexEntry> index_;
+    uint64_t fileBytes_ = 0;
+    size_t capacity_ = 64;
+    std::unordered_map<int, CachedTile> cache_;
+    std::list<int> lru_;                // Most recently used first
+    size_t loads_ = 0;
+};
@@ -0,0 +1,204 @@
+// Headless parameter sweep / successive-halving tuner for the RRT* planner.
+// Runs every candidate setting over a set of maps with fixed seeds and writes
+// the fastest setting that meets the path quality target as a planner profile.
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+#include "map_io.h"
+#include "profile.h"
+
+const int canvasSize = 500;     // Same canvas the editor plans on
+
+// A map prepared for benchmarking
+struct BenchMap {
+    std::string name;
+    OccupancyGrid grid;                     // Points at overlays
+    std::shared_ptr<MapOverlays> overlays;  // Shared so copies of the map keep the pointers valid
+    cv::Point2f startPt, goalPt;
+    float reference;    // 8-connected shortest path length in pixels
+};
+
+// Aggregated results of one candidate setting
+struct Candidate {
+    PlannerParams params;
+    int runs = 0, failures = 0;
+    double meanMs = 0, meanQuality = 0;     // Quality = path length / reference length (successful runs)
+};
+
+// 8-connected Dijkstra without corner cutting, used as the quality reference
+static float referenceLength(const OccupancyGrid& grid, cv::Point s, cv::Point g) {
+    auto centre = [&](int r, int c) { return cv::Point2f((c + 0.5f) * grid.cellSize, (r + 0.5f) * grid.cellSize); };
+    std::vector<float> best((size_t)grid.rows * grid.cols, 1e30f);
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    best[s.y * grid.cols + s.x] = 0;
+    open.push({0.0f, s.y * grid.cols + s.x});
+    while (!open.empty()) {
+        auto [d, cur] = open.top(); open.pop();
+        if (d > best[cur]) continue;
+        int r = cur / grid.cols, c = cur % grid.cols;
+        if (r == g.y && c == g.x) return d * grid.cellSize;
+        for (int dr = -1; dr <= 1; ++dr) {
+            for (int dc = -1; dc <= 1; ++dc) {
+                if ((!dr && !dc) || grid.occupied(r + dr, c + dc)) continue;
+                if (dr && dc && (grid.occupied(r + dr, c) || grid.occupied(r, c + dc))) continue;
+                if (grid.polygons && grid.polygons->intersects(centre(r, c), centre(r + dr, c + dc))) continue;
+                float nd = d + (dr && dc ? 1.41421356f : 1.0f);
+                int next = (r + dr) * grid.cols + c + dc;
+                if (nd < best[next]) best[next] = nd, open.push({nd, next});
+            }
+        }
+    }
+    return -1;
+}
+
+static float pathLength(const std::vector<cv::Point2f>& path) {
+    float len = 0;
+    for (size_t i = 1; i < path.size(); ++i) len += dist(path[i - 1], path[i]);
+    return len;
+}
+
+// Runs a candidate on every map with seeds [0, seeds) and stores the aggregates
+static void evaluate(Candidate& cand, const std::vector<BenchMap>& maps, int seeds) {
+    cand.runs = cand.failures = 0;
+    double totalMs = 0, totalQuality = 0;
+    for (auto& map : maps) {
+        for (int seed = 0; seed < seeds; ++seed) {
+            std::mt19937 rng(seed);
+            auto t0 = std::chrono::steady_clock::now();
+            PlanResult res = planRRTStar(map.grid, canvasSize, map.startPt, map.goalPt, cand.params, rng);
+            totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            ++cand.runs;
+            if (res.found()) totalQuality += pathLength(res.smoothed) / map.reference;
+            else ++cand.failures;
+        }
+    }
+    cand.meanMs = totalMs / cand.runs;
+    int successes = cand.runs - cand.failures;
+    cand.meanQuality = successes ? totalQuality / successes : 1e9;
+}
+
+// Feasible candidates (no failures, quality within target) first, then by time
+static void rank(std::vector<Candidate>& cands, double quality) {
+    std::stable_sort(cands.begin(), cands.end(), [&](const Candidate& a, const Candidate& b) {
+        bool fa = a.failures == 0 && a.meanQuality <= quality, fb = b.failures == 0 && b.meanQuality <= quality;
+        if (fa != fb) return fa;
+        if (!fa && a.failures != b.failures) return a.failures < b.failures;
+        return a.meanMs < b.meanMs;
+    });
+}
+
+// Cartesian product of the parameter grid
+static std::vector<Candidate> parameterGrid() {
+    std::vector<Candidate> cands;
+    for (float step : {25.0f, 50.0f, 75.0f, 100.0f})
+        for (int bias : {3, 5, 10})
+            for (float radius : {25.0f, 50.0f, 100.0f, 200.0f})
+                for (int iters : {2500, 5000, 10000})
+                    for (int mode = 0; mode < 4; ++mode) {
+                        Candidate c;
+                        c.params.stepSize = step;
+                        c.params.goalBiasPeriod = bias;
+                        c.params.radiusScale = radius;
+                        c.params.maxIter = iters;
+                        c.params.hierarchical = mode & 1;
+                        c.params.narrowPassage = mode & 2;
+                        cands.push_back(c);
+                    }
+    return cands;
+}
+
+static void printCandidate(const Candidate& c) {
+    std::cout << "step=" << c.params.stepSize << " bias=" << c.params.goalBiasPeriod
+              << " radius=" << c.params.radiusScale << " iters=" << c.params.maxIter
+              << " hier=" << c.params.hierarchical << " narrow=" << c.params.narrowPassage
+              << " | " << c.meanMs << " ms, quality " << c.meanQuality
+              << ", " << c.failures << "/" << c.runs << " failed\n";
+}
+
+int main(int argc, char** argv) {
+    std::string search = "halving", mapClass = "default", out;
+    int seeds = 5;
+    double quality = 1.2;
+    std::vector<std::string> mapPaths;
+
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--search") && hasValue) search = argv[++i];
+        else if (!std::strcmp(argv[i], "--seeds") && hasValue) seeds = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(argv[i], "--quality") && hasValue) quality = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--class") && hasValue) mapClass = argv[++i];
+        else if (!std::strcmp(argv[i], "--out") && hasValue) out = argv[++i];
+        else mapPaths.push_back(argv[i]);
+    }
+    if (mapPaths.empty() || (search != "grid" && search != "halving")) {
+        std::cout << "Usage: RRTTune [--search grid|halving] [--seeds N] [--quality Q] [--class NAME] [--out FILE] map...\n";
+        return 1;
+    }
+    if (out.empty()) out = mapClass + ".profile";
+
+    // Load maps and compute their reference path lengths
+    std::vector<BenchMap> maps;
+    for (auto& path : mapPaths) {
+        MapFile file;
+        if (!loadMap(path, file, canvasSize)) continue;
+        if (file.start.x == -1 || file.goal.x == -1) {
+            std::cout << "Skipping " << path << ": no start/goal\n";
+            continue;
+        }
+        BenchMap map;
+        map.name = path;
+        int cellSize = canvasSize / file.gridSize;
+        map.grid = buildOccupancyGrid(file.obstacles, file.gridSize, cellSize);
+        map.overlays = std::make_shared<MapOverlays>();
+        map.overlays->build(file, cellSize);
+        map.overlays->attach(map.grid);
+        map.startPt = cv::Point2f(file.start.x * cellSize + cellSize / 2, file.start.y * cellSize + cellSize / 2);
+        map.goalPt = cv::Point2f(file.goal.x * cellSize + cellSize / 2, file.goal.y * cellSize + cellSize / 2);
+        map.reference = referenceLength(map.grid, file.start, file.goal);
+        if (map.reference <= 0) {
+            std::cout << "Skipping " << path << ": goal unreachable\n";
+            continue;
+        }
+        maps.push_back(map);
+    }
+    if (maps.empty()) return 1;
+
+    std::vector<Candidate> cands = parameterGrid();
+    if (search == "grid") {
+        for (auto& c : cands) evaluate(c, maps, seeds);
+    } else {
+        // Successive halving: keep the best third while doubling the seed budget
+        for (int budget = 1; cands.size() > 1; budget = std::min(budget * 2, seeds)) {
+            for (auto& c : cands) evaluate(c, maps, budget);
+            rank(cands, quality);
+            std::cout << cands.size() << " candidates at " << budget << " seed(s), best: ";
+            printCandidate(cands.front());
+            cands.resize((cands.size() + 2) / 3);
+        }
+        evaluate(cands.front(), maps, seeds);
+    }
+    rank(cands, quality);
+
+    std::cout << "Top settings:\n";
+    for (size_t i = 0; i < std::min<size_t>(5, cands.size()); ++i) printCandidate(cands[i]);
+
+    const Candidate& best = cands.front();
+    if (best.failures || best.meanQuality > quality)
+        std::cout << "Warning: no setting met quality " << quality << " on every run\n";
+    std::string header = "Map class: " + mapClass + "\nTuned on " + std::to_string(maps.size()) + " map(s), "
+                       + std::to_string(seeds) + " seed(s), quality target " + std::to_string(quality)
+                       + "\nMean time-to-solution: " + std::to_string(best.meanMs) + " ms";
+    if (!saveProfile(out, best.params, header)) {
+        std::cout << "Cannot write " << out << "\n";
+        return 1;
+    }
+    std::cout << "Profile written to " << out << "\n";
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include "visibility_graph.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+// Distance a corner node is pushed away from its obstacle, in pixels
+static const float CORNER_OFFSET = 0.5f;
+
+// A grid vertex is a convex corner if exactly one of the four cells around it is occupied
+static void findCorners(const OccupancyGrid& grid, std::vector<cv::Point2f>& corners) {
+    auto occ = [&](int r, int c) { return grid.inside(r, c) && grid.data()[r * grid.cols + c]; };
+    for (int r = 0; r <= grid.rows; ++r) {
+        for (int c = 0; c <= grid.cols; ++c) {
+            // Quadrants: up-left, up-right, down-left, down-right
+            bool q[4] = {occ(r - 1, c - 1), occ(r - 1, c), occ(r, c - 1), occ(r, c)};
+            if (q[0] + q[1] + q[2] + q[3] != 1) continue;
+            int k = std::find(q, q + 4, true) - q;
+            float dx = (k & 1) ? -CORNER_OFFSET : CORNER_OFFSET, dy = (k & 2) ? -CORNER_OFFSET : CORNER_OFFSET;
+            cv::Point2f pt(c * grid.cellSize + dx, r * grid.cellSize + dy);
+            if (pt.x > 0 && pt.y > 0 && pt.x < grid.cols * grid.cellSize && pt.y < grid.rows * grid.cellSize && !isObstacle(grid, pt))
+                corners.push_back(pt);
+        }
+    }
+}
+
+// Convex polygon vertices, pushed out along the bisector to CORNER_OFFSET from both adjacent edges
+static void findPolygonCorners(const OccupancyGrid& grid, std::vector<cv::Point2f>& corners) {
+    auto cross = [](const cv::Point2f& a, const cv::Point2f& b) { return a.x * b.y - a.y * b.x; };
+    for (const Polygon& poly : grid.polygons->polygons()) {
+        size_t n = poly.size();
+        float area = 0;     // Twice the signed area; its sign gives the winding
+        for (size_t i = 0; i < n; ++i) area += cross(poly[i], poly[(i + 1) % n]);
+        for (size_t i = 0; i < n; ++i) {
+            cv::Point2f v = poly[i], prev = poly[(i + n - 1) % n], next = poly[(i + 1) % n];
+            if (cross(v - prev, next - v) * area <= 0) continue;   // Reflex or collinear
+            cv::Point2f u1 = prev - v, u2 = next - v;
+            u1 *= 1.0f / cv::norm(u1), u2 *= 1.0f / cv::norm(u2);
+            cv::Point2f bisector = u1 + u2;
+            float halfSin = cv::norm(u1 - u2) / 2;     // sin of half the interior angle
+            cv::Point2f pt = v - bisector * (CORNER_OFFSET / (halfSin * (float)cv::norm(bisector)));
+            if (pt.x > 0 && pt.y > 0 && pt.x < grid.cols * grid.cellSize && pt.y < grid.rows * grid.cellSize && !isObstacle(grid, pt))
+                corners.push_back(pt);
+        }
+    }
+}
+
+void VisibilityGraph::build(const OccupancyGrid& grid, uint64_t mapVersion, int threads) {
+    version = mapVersion;
+    corners.clear();
+    findCorners(grid, corners);
+    if (grid.polygons) findPolygonCorners(grid, corners);
+    size_t n = corners.size();
+
+    // Each worker claims source corners and tests them against every later corner
+    std::vector<std::vector<int>> visible(n);
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = (int)std::min<size_t>(threads, std::max<size_t>(n, 1));
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        for (size_t i; (i = next.fetch_add(1)) < n;)
+            for (size_t j = i + 1; j < n; ++j)
+                if (traversalFree(grid, corners[i], corners[j])) visible[i].push_back((int)j);
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(work);
+    work();
+    for (auto& t : pool) t.join();
+
+    // Symmetric CSR adjacency
+    edgeStart.assign(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        edgeStart[i + 1] += visible[i].size();
+        for (int j : visible[i]) ++edgeStart[j + 1];
+    }
+    for (size_t i = 1; i <= n; ++i) edgeStart[i] += edgeStart[i - 1];
+    edgeTo.assign(edgeStart[n], 0);
+    edgeLength.assign(edgeStart[n], 0);
+    std::vector<int> fill(edgeStart.begin(), edgeStart.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        for (int j : visible[i]) {
+            float len = cv::norm(corners[i] - corners[j]);
+            edgeTo[fill[i]] = j, edgeLength[fill[i]++] = len;
+            edgeTo[fill[j]] = (int)i, edgeLength[fill[j]++] = len;
+        }
+    }
+}
+
+uint64_t gridVersion(const OccupancyGrid& grid) {
+    // FNV-1a over the dimensions, cells, polygon vertices and cost levels
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&](uint64_t v) { h = (h ^ v) * 1099511628211ull; };
+    mix(grid.rows), mix(grid.cols), mix(grid.cellSize);
+    const uint8_t* cells = grid.data();
+    for (size_t i = 0; i < (size_t)grid.rows * grid.cols; ++i) mix(cells[i]);
+    if (grid.polygons) {
+        for (const Polygon& poly : grid.polygons->polygons()) {
+            mix(poly.size());
+            for (const cv::Point2f& p : poly) {
+                uint32_t x, y;
+                std::memcpy(&x, &p.x, 4), std::memcpy(&y, &p.y, 4);
+                mix(x), mix(y);
+            }
+        }
+    }
+    if (grid.costs)
+        for (int r = 0; r < grid.rows; ++r)
+            for (int c = 0; c < grid.cols; ++c) mix(grid.costs->level(r, c) + 1);
+    return h;
+}
+
+std::shared_ptr<const VisibilityGraph> cachedVisibilityGraph(const OccupancyGrid& grid, uint64_t version, int threads) {
+    static std::mutex mutex;
+    static std::deque<std::shared_ptr<const VisibilityGraph>> recent;   // Most recent first
+    const size_t keep = 4;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& g : recent)
+            if (g->version == version) return g;
+    }
+
+    // Build outside the lock so other versions can still be served
+    auto graph = std::make_shared<VisibilityGraph>();
+    graph->build(grid, version, threads);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    recent.push_front(graph);
+    if (recent.size() > keep) recent.pop_back();
+    return graph;
+}
+
+std::vector<cv::Point2f> visibilityPath(const VisibilityGraph& graph, const OccupancyGrid& grid,
+                                        const cv::Point2f& start, const cv::Point2f& goal) {
+    if (isObstacle(grid, start) || isObstacle(grid, goal)) return {};
+    if (traversalFree(grid, start, goal)) return {start, goal};
+
+    // Corners 0..n-1, start n, goal n+1; start and goal edges are found per query
+    int n = graph.corners.size(), s = n, g = n + 1;
+    auto point = [&](int v) { return v == s ? start : v == g ? goal : graph.corners[v]; };
+    std::vector<float> costs(n + 2, std::numeric_limits<float>::infinity());
+    std::vector<int> parent(n + 2, -1);
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    costs[s] = 0;
+    open.push({(float)cv::norm(goal - start), s});
+
+    while (!open.empty()) {
+        auto [f, v] = open.top();
+        open.pop();
+        if (v == g) break;
+        if (f > costs[v] + cv::norm(goal - point(v)) + 1e-3f) continue;
+
+        auto relax = [&](int u, float len) {
+            if (costs[v] + len < costs[u]) {
+                costs[u] = costs[v] + len;
+                parent[u] = v;
+                open.push({costs[u] + (float)cv::norm(goal - point(u)), u});
+            }
+        };
+        if (v == s) {
+            for (int u = 0; u < n; ++u)
+                if (traversalFree(grid, start, graph.corners[u])) relax(u, cv::norm(graph.corners[u] - start));
+            continue;
+        }
+        for (int k = graph.edgeStart[v]; k < graph.edgeStart[v + 1]; ++k) relax(graph.edgeTo[k], graph.edgeLength[k]);
+        if (traversalFree(grid, graph.corners[v], goal)) relax(g, cv::norm(goal - graph.corners[v]));
+    }
+
+    if (parent[g] == -1) return {};
+    std::vector<cv::Point2f> path;
+    for (int v = g; v != -1; v = parent[v]) path.push_back(point(v));
+    std::reverse(path.begin(), path.end());
+    return path;
+}
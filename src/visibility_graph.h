@@ -0,0 +1,31 @@
+#pragma once
+
+#include "occupancy_grid.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Visibility graph over the convex obstacle corners of a grid and its polygons.
+// Shortest paths among polygonal obstacles bend only at convex corners, so a
+// query is a small A* run over this graph instead of a sampling loop.
+struct VisibilityGraph {
+    uint64_t version = 0;                   // Map version the graph was built for
+    std::vector<cv::Point2f> corners;       // Nudged just off the obstacle into free space
+    std::vector<int> edgeStart;             // CSR offsets, corners.size() + 1 entries
+    std::vector<int> edgeTo;
+    std::vector<float> edgeLength;
+
+    // Line-of-sight tests between corner pairs are split across threads (0 = hardware concurrency)
+    void build(const OccupancyGrid& grid, uint64_t version, int threads = 0);
+    size_t edgeCount() const { return edgeTo.size() / 2; }
+};
+
+// Hash of the cells, polygons and cost levels, for callers that do not track map versions themselves
+uint64_t gridVersion(const OccupancyGrid& grid);
+
+// Process-wide graph for a map version, built on first use; the most recent few versions are kept
+std::shared_ptr<const VisibilityGraph> cachedVisibilityGraph(const OccupancyGrid& grid, uint64_t version, int threads = 0);
+
+// Shortest collision-free polyline from start to goal through the graph; empty if none exists
+std::vector<cv::Point2f> visibilityPath(const VisibilityGraph& graph, const OccupancyGrid& grid,
+                                        const cv::Point2f& start, const cv::Point2f& goal);
@@ -0,0 +1,144 @@
+#include "worker_pool.h"
+#include "counter_rng.h"
+#include "mapped_grid.h"
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+#include <new>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Body of a worker process; never returns
+[[noreturn]] static void workerMain(PoolShared* shared, int slot, const std::string& occupancyPath,
+                                    int canvasSize, const PlannerParams& params, const MapOverlays* overlays) {
+    MappedGrid map;
+    if (!map.open(occupancyPath)) _exit(1);
+    OccupancyGrid grid = map.grid();
+    if (overlays) overlays->attach(grid);
+
+    for (;;) {
+        if (sem_wait(&shared->queued) != 0) {
+            if (errno == EINTR) continue;
+            _exit(1);
+        }
+        if (shared->stop.load()) break;
+
+        // Claim before popping and pop straight into shared memory, so a
+        // crash at any point still leaves the query visible to the supervisor
+        shared->taken[slot].id = NO_QUERY;
+        shared->inFlight[slot].store(CLAIMING);
+        if (!shared->queries.pop(shared->taken[slot])) {
+            shared->inFlight[slot].store(0);
+            continue;
+        }
+        PlanQuery query = shared->taken[slot];
+        shared->inFlight[slot].store(query.id + 1);
+
+        std::mt19937 rng = streamEngine(query.seed, query.id);
+        PlanResult res = planRRTStar(grid, canvasSize, cv::Point2f(query.startX, query.startY),
+                                     cv::Point2f(query.goalX, query.goalY), params, rng);
+
+        PlanReply reply;
+        reply.id = query.id;
+        reply.status = res.found() ? ReplyStatus::Found : ReplyStatus::NotFound;
+        reply.cost = res.found() ? res.tree[res.goalIdx].cost : 0;
+        reply.numPoints = std::min((int)res.smoothed.size(), MAX_REPLY_POINTS);
+        for (int i = 0; i < reply.numPoints; ++i) {
+            reply.points[i][0] = res.smoothed[i].x;
+            reply.points[i][1] = res.smoothed[i].y;
+        }
+        while (!shared->replies.push(reply)) usleep(100);
+        shared->inFlight[slot].store(0);
+    }
+    _exit(0);
+}
+
+WorkerPool::WorkerPool(const std::string& occupancyPath, int canvasSize, const PlannerParams& params, int workers,
+                       const MapOverlays* overlays)
+    : occupancyPath_(occupancyPath), canvasSize_(canvasSize), params_(params),
+      workers_(std::clamp(workers, 1, MAX_WORKERS)), overlays_(overlays) {}
+
+WorkerPool::~WorkerPool() {
+    shutdown();
+}
+
+bool WorkerPool::start() {
+    // Anonymous shared mapping, inherited by every forked worker
+    void* mem = mmap(nullptr, sizeof(PoolShared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) return false;
+    shared_ = new (mem) PoolShared;
+    if (sem_init(&shared_->queued, 1, 0) != 0) {
+        munmap(mem, sizeof(PoolShared));
+        shared_ = nullptr;
+        return false;
+    }
+    shared_->stop.store(0);
+    for (auto& id : shared_->inFlight) id.store(0);
+    shared_->queries.init();
+    shared_->replies.init();
+
+    pids_.assign(workers_, -1);
+    for (int slot = 0; slot < workers_; ++slot) spawn(slot);
+    return true;
+}
+
+void WorkerPool::spawn(int slot) {
+    pid_t pid = fork();
+    if (pid == 0) workerMain(shared_, slot, occupancyPath_, canvasSize_, params_, overlays_);
+    if (pid < 0) std::cout << "Cannot fork worker " << slot << "\n";
+    pids_[slot] = pid;
+}
+
+void WorkerPool::shutdown() {
+    if (!shared_) return;
+    shared_->stop.store(1);
+    for (int i = 0; i < workers_; ++i) sem_post(&shared_->queued);
+    for (pid_t pid : pids_)
+        if (pid > 0) waitpid(pid, nullptr, 0);
+    pids_.clear();
+    sem_destroy(&shared_->queued);
+    shared_->~PoolShared();
+    munmap(shared_, sizeof(PoolShared));
+    shared_ = nullptr;
+}
+
+bool WorkerPool::submit(const PlanQuery& query) {
+    if (!shared_ || !shared_->queries.push(query)) return false;
+    sem_post(&shared_->queued);
+    return true;
+}
+
+void WorkerPool::reap() {
+    // Only our own workers; other children of the process are left alone
+    int status;
+    for (int slot = 0; slot < workers_; ++slot) {
+        if (pids_[slot] <= 0 || waitpid(pids_[slot], &status, WNOHANG) != pids_[slot]) continue;
+        uint64_t current = shared_->inFlight[slot].exchange(0);
+        if (current == CLAIMING) current = shared_->taken[slot].id == NO_QUERY ? 0 : shared_->taken[slot].id + 1;
+        if (current != 0) {
+            PlanReply reply = {};
+            reply.id = current - 1;
+            reply.status = ReplyStatus::WorkerCrashed;
+            crashed_.push_back(reply);
+        }
+        std::cout << "Worker " << slot << " exited, restarting\n";
+        spawn(slot);
+    }
+}
+
+bool WorkerPool::poll(PlanReply& reply) {
+    if (!shared_) return false;
+    reap();
+
+    // Real replies first: a worker that crashed after pushing its reply is
+    // also reported as crashed, and that report is then dropped
+    while (shared_->replies.pop(reply))
+        if (answered_.insert(reply.id).second) return true;
+    while (!crashed_.empty()) {
+        reply = crashed_.front();
+        crashed_.pop_front();
+        if (answered_.insert(reply.id).second) return true;
+    }
+    return false;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "map_io.h"
+#include "planner.h"
+#include "shm_ring.h"
+#include <deque>
+#include <semaphore.h>
+#include <string>
+#include <unordered_set>
+#include <sys/types.h>
+
+const int MAX_WORKERS = 64;           // Upper bound on pool size (in-flight table is fixed)
+const int MAX_REPLY_POINTS = 256;     // Longest path a reply can carry
+const uint64_t CLAIMING = ~0ull;      // In-flight marker while a worker takes a query off the ring
+const uint64_t NO_QUERY = ~0ull;      // Query id of an empty taken slot
+
+// Query sent to a worker, in pixel coordinates
+struct PlanQuery {
+    uint64_t id;
+    float startX, startY, goalX, goalY;
+    uint32_t seed;
+};
+
+enum class ReplyStatus : int32_t { Found, NotFound, WorkerCrashed };
+
+// Reply from a worker; the smoothed path is stored inline so it can cross processes
+struct PlanReply {
+    uint64_t id;
+    ReplyStatus status;
+    float cost;
+    int32_t numPoints;
+    float points[MAX_REPLY_POINTS][2];
+};
+
+// Block shared by the supervisor and all workers
+struct PoolShared {
+    sem_t queued;                                   // Posted once per submitted query
+    std::atomic<int> stop;
+    std::atomic<uint64_t> inFlight[MAX_WORKERS];    // Query id + 1 per worker, CLAIMING while popping, 0 when idle
+    PlanQuery taken[MAX_WORKERS];                   // Query each worker popped, written by the pop itself
+    ShmRing<PlanQuery, 1024> queries;
+    ShmRing<PlanReply, 256> replies;
+};
+
+// Supervisor for forked planner workers (POSIX). Every worker maps the same
+// read-only occupancy file, so map memory is paid once in the page cache, and
+// a worker that crashes only fails its current query and is restarted.
+// Optional map overlays (polygons, soft costs) are inherited through fork().
+// Create the pool before starting any threads in the supervisor process.
+class WorkerPool {
+public:
+    WorkerPool(const std::string& occupancyPath, int canvasSize, const PlannerParams& params, int workers,
+               const MapOverlays* overlays = nullptr);
+    ~WorkerPool();
+
+    bool start();
+    void shutdown();
+
+    // Returns false if the query ring is full
+    bool submit(const PlanQuery& query);
+
+    // Non-blocking; also reaps crashed workers, reporting their queries as
+    // WorkerCrashed. Every query id is returned at most once.
+    bool poll(PlanReply& reply);
+
+private:
+    void spawn(int slot);
+    void reap();
+
+    std::string occupancyPath_;
+    int canvasSize_;
+    PlannerParams params_;
+    int workers_;
+    const MapOverlays* overlays_;
+    PoolShared* shared_ = nullptr;
+    std::vector<pid_t> pids_;
+    std::deque<PlanReply> crashed_;
+    std::unordered_set<uint64_t> answered_;    // Ids already returned by poll()
+};
@@ -0,0 +1,34 @@
+#include "batch_planner.h"
+#include "test_check.h"
+
+// Results depend only on (seed, id), not on the thread count
+static void testThreadCountDoesNotChangeResults() {
+    OccupancyGrid grid = wallGrid();
+    PlannerParams params;
+    params.maxIter = 4000;
+    std::vector<BatchQuery> queries;
+    for (uint64_t id = 0; id < 8; ++id)
+        queries.push_back({id, cellCentre(grid, 2 + (int)id, 2), cellCentre(grid, 22 - (int)id, 22)});
+
+    auto serial = planBatch(grid, 500, queries, params, 99, 1);
+    auto parallel = planBatch(grid, 500, queries, params, 99, 4);
+    CHECK(serial.size() == queries.size() && parallel.size() == queries.size());
+    for (size_t i = 0; i < serial.size() && i < parallel.size(); ++i) {
+        CHECK(serial[i].found() == parallel[i].found());
+        CHECK(serial[i].smoothed == parallel[i].smoothed);
+        if (serial[i].found()) {
+            CHECK(serial[i].path.front() == queries[i].start);
+            CHECK(pathFree(grid, serial[i].smoothed));
+        }
+    }
+
+    auto reseeded = planBatch(grid, 500, queries, params, 100, 4);
+    bool anyDifferent = false;
+    for (size_t i = 0; i < serial.size(); ++i) anyDifferent |= serial[i].path != reseeded[i].path;
+    CHECK(anyDifferent);
+}
+
+int main() {
+    testThreadCountDoesNotChangeResults();
+    return checkResult();
+}
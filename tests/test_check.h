@@ -0,0 +1,59 @@
+#pragma once
+
+#include "occupancy_grid.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Minimal checks for the test executables: a failed CHECK reports the
+// expression and the run carries on, so one run lists every failure
+inline int& checkFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(cond)                                                                          \
+    do {                                                                                     \
+        if (!(cond)) {                                                                       \
+            std::cout << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #cond "\n";      \
+            ++checkFailures();                                                               \
+        }                                                                                    \
+    } while (0)
+
+// Exit code for main()
+inline int checkResult() {
+    if (checkFailures()) std::cout << checkFailures() << " check(s) failed\n";
+    return checkFailures() ? 1 : 0;
+}
+
+// Grid from rows of '#' (obstacle) and '.' (free)
+inline OccupancyGrid gridFromRows(const std::vector<std::string>& rows, int cellSize) {
+    OccupancyGrid grid;
+    grid.rows = (int)rows.size();
+    grid.cols = (int)rows[0].size();
+    grid.cellSize = cellSize;
+    for (auto& row : rows)
+        for (char ch : row) grid.cells.push_back(ch == '#');
+    return grid;
+}
+
+// 25x25 grid of 20-pixel cells (the 500-pixel canvas) with a vertical wall
+// down column 12 that has a three-cell gap at rows 20-22
+inline OccupancyGrid wallGrid() {
+    std::vector<std::string> rows(25, std::string(25, '.'));
+    for (int r = 0; r < 25; ++r)
+        if (r < 20 || r > 22) rows[r][12] = '#';
+    return gridFromRows(rows, 20);
+}
+
+// Pixel centre of a cell
+inline cv::Point2f cellCentre(const OccupancyGrid& grid, int r, int c) {
+    return cv::Point2f((c + 0.5f) * grid.cellSize, (r + 0.5f) * grid.cellSize);
+}
+
+// Every segment passes the planner's collision check
+inline bool pathFree(const OccupancyGrid& grid, const std::vector<cv::Point2f>& path) {
+    for (size_t i = 1; i < path.size(); ++i)
+        if (!collisionFree(grid, path[i - 1], path[i])) return false;
+    return true;
+}
@@ -0,0 +1,129 @@
+#include "compact_tree.h"
+#include "test_check.h"
+#include <random>
+
+// Snapped points decode exactly and lie within half a fixed-point step of the input
+static void testPointQuantization() {
+    CompactTree tree(500);
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> coord(0, 500);
+    float step = 500 / 65535.0f;
+    for (int i = 0; i < 10000; ++i) {
+        cv::Point2f pt(coord(rng), coord(rng));
+        cv::Point2f snapped = tree.snap(pt);
+        CHECK(std::abs(snapped.x - pt.x) <= step * 0.5f + 1e-4f && std::abs(snapped.y - pt.y) <= step * 0.5f + 1e-4f);
+        uint32_t idx = tree.add(snapped, CompactTree::NO_PARENT, 0);
+        CHECK(tree.point(idx) == snapped);
+    }
+    CHECK(tree.snap(cv::Point2f(-5, 600)) == cv::Point2f(0, 500));
+}
+
+// Packed costs round up by at most one part in 2^11 and keep their order
+static void testCostQuantization() {
+    CompactTree tree(500);
+    tree.reserve(10001);
+    uint32_t root = tree.add(tree.snap(cv::Point2f(0, 0)), CompactTree::NO_PARENT, 0);
+    CHECK(tree.cost(root) == 0);
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> logCost(-3, 6);
+    float prevIn = 0, prevOut = 0;
+    std::vector<float> costs;
+    for (int i = 0; i < 10000; ++i) costs.push_back(std::pow(10.0f, logCost(rng)));
+    std::sort(costs.begin(), costs.end());
+    for (float cost : costs) {
+        uint32_t idx = tree.add(tree.snap(cv::Point2f(1, 1)), root, cost);
+        float stored = tree.cost(idx);
+        CHECK(stored >= cost);
+        CHECK(stored <= cost * (1 + 1.0f / 2048) || cost < 0.0625f);
+        if (cost >= prevIn) CHECK(stored >= prevOut);
+        prevIn = cost, prevOut = stored;
+        CHECK(!tree.improves(idx, stored));
+        CHECK(tree.improves(idx, stored * 0.99f) || stored <= 0.0625f);
+    }
+    CHECK(tree.size() == 10001 && tree.bytes() == 10001 * 10);
+}
+
+// Nearest and radius queries agree with a brute-force scan (queries are snapped like nodes)
+static void testQueries() {
+    CompactTree tree(500);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> coord(0, 500);
+    for (int i = 0; i < 3000; ++i) tree.add(tree.snap(cv::Point2f(coord(rng), coord(rng))), 0, 0);
+    std::vector<uint32_t> near;
+    for (int q = 0; q < 200; ++q) {
+        cv::Point2f pt = tree.snap(cv::Point2f(coord(rng), coord(rng)));
+        float best = 1e9f;
+        for (uint32_t i = 0; i < tree.size(); ++i) best = std::min(best, dist(tree.point(i), pt));
+        CHECK(dist(tree.point(tree.nearest(pt)), pt) == best);
+
+        near.clear();
+        tree.near(pt, 30, near);
+        size_t expected = 0;
+        for (uint32_t i = 0; i < tree.size(); ++i) expected += dist(tree.point(i), pt) < 30;
+        CHECK(near.size() == expected);
+        for (uint32_t i : near) CHECK(dist(tree.point(i), pt) < 30);
+    }
+}
+
+// The compact planner's paths are valid and its costs track the Node planner's
+static void testPlanner() {
+    OccupancyGrid grid = wallGrid();
+    PlannerParams params;
+    params.maxIter = 4000;
+    params.anytime = true;
+    cv::Point2f start = cellCentre(grid, 2, 2), goal = cellCentre(grid, 2, 22);
+    std::mt19937 rng(4);
+    CompactPlanResult result = planCompactRRTStar(grid, 500, start, goal, params, rng);
+    CHECK(result.found());
+    CHECK(result.tree.bytes() >= result.tree.size() * 10);
+    CHECK(pathFree(grid, result.path));
+    CHECK(pathFree(grid, result.smoothed));
+    CHECK(dist(result.path.front(), start) < 0.01f && dist(result.path.back(), goal) < grid.cellSize);
+
+    // Every stored cost covers the parent's cost plus the edge, so parent chains cannot loop
+    for (uint32_t i = 1; i < result.tree.size(); ++i) {
+        uint32_t p = result.tree.parent(i);
+        CHECK(p < result.tree.size());
+        CHECK(result.tree.cost(i) >= result.tree.cost(p) + dist(result.tree.point(p), result.tree.point(i)) * 0.999f);
+    }
+    float length = 0;
+    for (size_t i = 1; i < result.path.size(); ++i) length += dist(result.path[i - 1], result.path[i]);
+    CHECK(result.tree.cost(result.goalIdx) >= length * 0.999f);
+    CHECK(result.tree.cost(result.goalIdx) <= length * 1.01f);
+
+    std::mt19937 rngNode(4);
+    PlanResult node = planRRTStar(grid, 500, start, goal, params, rngNode);
+    CHECK(node.found());
+    CHECK(std::abs(result.tree.cost(result.goalIdx) - node.tree[node.goalIdx].cost) < 0.1f * node.tree[node.goalIdx].cost);
+}
+
+// edgeValid sees consistent path lengths and its rejections shape the tree
+static void testEdgeValid() {
+    OccupancyGrid grid = gridFromRows(std::vector<std::string>(25, std::string(25, '.')), 20);
+    PlannerHooks hooks;
+    int calls = 0, mismatches = 0;
+    auto blocked = [](const cv::Point2f& p) { return p.x >= 200 && p.x <= 300 && p.y < 350; };
+    hooks.edgeValid = [&](const cv::Point2f& from, float fromLength, const cv::Point2f& to, float toLength) {
+        ++calls;
+        mismatches += std::abs(toLength - fromLength - (float)cv::norm(to - from)) > 1e-3f * (1 + toLength);
+        return !blocked(to);
+    };
+    PlannerParams params;
+    params.maxIter = 4000;
+    params.anytime = true;
+    std::mt19937 rng(6);
+    cv::Point2f start = cellCentre(grid, 2, 2), goal = cellCentre(grid, 2, 22);
+    CompactPlanResult result = planCompactRRTStar(grid, 500, start, goal, params, rng, hooks);
+    CHECK(result.found());
+    CHECK(calls > 0 && mismatches == 0);
+    for (const cv::Point2f& p : result.path) CHECK(!blocked(p));
+}
+
+int main() {
+    testPointQuantization();
+    testCostQuantization();
+    testQueries();
+    testPlanner();
+    testEdgeValid();
+    return checkResult();
+}
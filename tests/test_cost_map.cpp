@@ -0,0 +1,85 @@
+#include "cost_map.h"
+#include "planner.h"
+#include "test_check.h"
+#include <random>
+
+// Midpoint-rule integral of the cell factors along a-b
+static float numericCost(const std::vector<uint8_t>& levels, int rows, int cols, int cellSize, const cv::Point2f& a,
+                         const cv::Point2f& b) {
+    const int steps = 20000;
+    float total = 0, len = cv::norm(b - a);
+    for (int k = 0; k < steps; ++k) {
+        cv::Point2f p = a + (b - a) * ((k + 0.5f) / steps);
+        int r = (int)std::floor(p.y / cellSize), c = (int)std::floor(p.x / cellSize);
+        uint8_t level = r >= 0 && r < rows && c >= 0 && c < cols ? levels[r * cols + c] : 0;
+        total += CostMap::factor(level) * len / steps;
+    }
+    return total;
+}
+
+// Exact integration and the uniform-block fast path both match a numeric integral
+static void testEdgeCostMatchesIntegral() {
+    const int rows = 40, cols = 40, cellSize = 10;
+    std::mt19937 rng(13);
+    std::vector<uint8_t> levels(rows * cols, 0);
+    for (int r = 0; r < 24; ++r)
+        for (int c = 0; c < cols; ++c) levels[r * cols + c] = rng() % 160;
+    for (int r = 24; r < rows; ++r)
+        for (int c = 0; c < cols; ++c) levels[r * cols + c] = 32;      // Uniform blocks
+    CostMap costs;
+    costs.build(rows, cols, cellSize, levels);
+
+    std::uniform_real_distribution<float> coord(-20, 420);
+    for (int i = 0; i < 300; ++i) {
+        cv::Point2f a(coord(rng), coord(rng)), b(coord(rng), coord(rng));
+        float expected = numericCost(levels, rows, cols, cellSize, a, b);
+        CHECK(std::abs(costs.edgeCost(a, b) - expected) < 1e-2f * (1 + expected));
+        CHECK(costs.edgeCost(a, b) >= cv::norm(b - a) * 0.9999f);
+    }
+    cv::Point2f a(245, 250), b(390, 385);
+    CHECK(std::abs(costs.edgeCost(a, b) - cv::norm(b - a) * CostMap::factor(32)) < 1e-3f * cv::norm(b - a));
+    CHECK(costs.edgeCost(a, a) == 0);
+
+    CostMap empty;
+    CHECK(empty.edgeCost(a, b) == (float)cv::norm(b - a));
+}
+
+// Plans detour around an expensive band, and stored costs are the integrals along the path
+static void testPlannerUsesCosts() {
+    OccupancyGrid grid = gridFromRows(std::vector<std::string>(25, std::string(25, '.')), 20);
+    std::vector<uint8_t> levels(25 * 25, 0);
+    for (int r = 0; r < 20; ++r)
+        for (int c = 10; c < 15; ++c) levels[r * 25 + c] = 255;
+    CostMap costs;
+    costs.build(25, 25, 20, levels);
+    grid.costs = &costs;
+
+    PlannerParams params;
+    params.maxIter = 6000;
+    params.anytime = true;
+    params.radiusScale = 2000;     // Wide rewiring so the tree converges on the detour
+    cv::Point2f start = cellCentre(grid, 2, 2), goal = cellCentre(grid, 2, 22);
+    std::mt19937 rng(14);
+    PlanResult result = planRRTStar(grid, 500, start, goal, params, rng);
+    CHECK(result.found());
+
+    float pathCost = 0, smoothedCost = 0;
+    for (size_t i = 1; i < result.path.size(); ++i) pathCost += edgeCost(grid, result.path[i - 1], result.path[i]);
+    for (size_t i = 1; i < result.smoothed.size(); ++i)
+        smoothedCost += edgeCost(grid, result.smoothed[i - 1], result.smoothed[i]);
+    CHECK(std::abs(result.tree[result.goalIdx].cost - pathCost) < 1e-3f * pathCost);
+    CHECK(smoothedCost <= pathCost * 1.0001f);
+
+    // Pixels in the band cost ~17x; the detour below it beats the straight line by far
+    float straight = edgeCost(grid, start, goal);
+    CHECK(pathCost < 0.6f * straight);
+    bool below = false;
+    for (const cv::Point2f& p : result.path) below |= p.y >= 400;
+    CHECK(below);
+}
+
+int main() {
+    testEdgeCostMatchesIntegral();
+    testPlannerUsesCosts();
+    return checkResult();
+}
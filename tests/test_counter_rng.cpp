@@ -0,0 +1,34 @@
+#include "counter_rng.h"
+#include "test_check.h"
+
+// Any position in a stream can be reached directly, and streams differ
+static void testCounterRng() {
+    CounterRng sequential(7, 3);
+    std::vector<uint32_t> words(41);
+    for (uint32_t& w : words) w = sequential();
+    for (uint64_t index : {0, 1, 3, 4, 17, 40}) {
+        CounterRng direct(7, 3, index);
+        CHECK(direct() == words[index]);
+        CounterRng seeked(7, 3);
+        seeked.seek(index);
+        CHECK(seeked() == words[index]);
+    }
+    CounterRng other(7, 4);
+    CHECK(other() != words[0] || other() != words[1]);
+
+    for (uint64_t i = 0; i < 1000; ++i) {
+        float u = sequential.uniformAt(i);
+        CHECK(u >= 0 && u < 1);
+    }
+    CHECK(sequential.uniformAt(5) == CounterRng(7, 3).uniformAt(5));
+
+    std::mt19937 s1 = streamEngine(1, 1), s1again = streamEngine(1, 1), s2 = streamEngine(1, 2);
+    uint32_t first = s1();
+    CHECK(first == s1again());
+    CHECK(first != s2());
+}
+
+int main() {
+    testCounterRng();
+    return checkResult();
+}
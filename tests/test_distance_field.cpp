@@ -0,0 +1,110 @@
+#include "compact_tree.h"
+#include "distance_field.h"
+#include "obstacle_rects.h"
+#include "test_check.h"
+#include <random>
+
+// Matches a brute-force nearest obstacle (or border) search at every cell centre
+static void testMatchesBruteForce() {
+    OccupancyGrid grid = wallGrid();
+    std::mt19937 rng(6);
+    for (int i = 0; i < 20; ++i) grid.cells[rng() % grid.cells.size()] = 1;
+    DistanceField field;
+    field.build(grid);
+    for (int r = 0; r < grid.rows; ++r)
+        for (int c = 0; c < grid.cols; ++c) {
+            float best = 1e9f;
+            for (int orow = -1; orow <= grid.rows; ++orow)
+                for (int ocol = -1; ocol <= grid.cols; ++ocol)
+                    if (grid.occupied(orow, ocol)) best = std::min(best, std::hypot((float)(orow - r), (float)(ocol - c)));
+            float expected = std::max(0.0f, best - 0.5f) * grid.cellSize;
+            CHECK(std::abs(field.at(cellCentre(grid, r, c)) - expected) < 1e-3f);
+        }
+}
+
+// Cells a polygon overlaps repel like occupied cells
+static void testPolygonsInField() {
+    std::vector<std::string> rows(25, std::string(25, '.'));
+    OccupancyGrid grid = gridFromRows(rows, 20);
+    PolygonBVH polygons;
+    polygons.build({{{102, 102}, {198, 102}, {198, 198}, {102, 198}},      // Covers cells 5..9 exactly
+                    {{405, 405}, {410, 405}, {407, 409}}});                // Inside cell (20, 20)
+    grid.polygons = &polygons;
+    DistanceField field;
+    field.build(grid);
+
+    for (int r = 5; r < 10; ++r) rows[r].replace(5, 5, "#####");
+    rows[20][20] = '#';
+    DistanceField expected;
+    expected.build(gridFromRows(rows, 20));
+    for (int r = 0; r < grid.rows; ++r)
+        for (int c = 0; c < grid.cols; ++c)
+            CHECK(std::abs(field.at(cellCentre(grid, r, c)) - expected.at(cellCentre(grid, r, c))) < 1e-3f);
+}
+
+// With a cost map, smoothing that would push the path into costlier cells is rejected
+static void testSmoothingKeepsCost() {
+    std::vector<std::string> rows(25, std::string(25, '.'));
+    rows[10] = std::string(25, '#');
+    OccupancyGrid grid = gridFromRows(rows, 20);
+    DistanceField field;
+    field.build(grid);
+    std::vector<cv::Point2f> path = {{50, 225}, {250, 225}, {450, 225}};    // 5 px below the wall
+
+    std::vector<cv::Point2f> out;
+    ClearanceSmoother(grid, field).smooth(path, out);
+    CHECK(out != path);                     // Without costs the path moves away from the wall
+
+    std::vector<uint8_t> levels(25 * 25, 0);
+    for (int c = 0; c < 25; ++c) levels[12 * 25 + c] = 255;
+    CostMap costs;
+    costs.build(25, 25, 20, levels);
+    grid.costs = &costs;
+    ClearanceSmoother(grid, field).smooth(path, out);
+    CHECK(out == path);
+}
+
+static float minClearance(const DistanceField& field, const std::vector<cv::Point2f>& path) {
+    float lowest = 1e9f;
+    for (size_t i = 1; i < path.size(); ++i)
+        for (int k = 0; k <= 20; ++k) lowest = std::min(lowest, field.at(path[i - 1] + (path[i] - path[i - 1]) * (k / 20.0f)));
+    return lowest;
+}
+
+// Both the node planner and the compact planner honour params.clearanceSmoothing
+static void testPlannersApplyClearanceSmoothing() {
+    OccupancyGrid grid = wallGrid();
+    ObstacleRects rects;
+    rects.build(grid);
+    grid.rects = &rects;
+    DistanceField field;
+    field.build(grid);
+    grid.distance = &field;
+    cv::Point2f start = cellCentre(grid, 2, 2), goal = cellCentre(grid, 2, 22);
+    PlannerParams params;
+    params.maxIter = 4000;
+
+    for (bool compact : {false, true}) {
+        std::vector<cv::Point2f> plain, cleared;
+        for (bool clearance : {false, true}) {
+            params.clearanceSmoothing = clearance;
+            std::mt19937 rng(12);
+            std::vector<cv::Point2f> smoothed =
+                compact ? planCompactRRTStar(grid, 500, start, goal, params, rng).smoothed
+                        : planRRTStar(grid, 500, start, goal, params, rng).smoothed;
+            (clearance ? cleared : plain) = smoothed;
+        }
+        CHECK(!plain.empty() && !cleared.empty());
+        CHECK(plain != cleared);
+        CHECK(pathFree(grid, cleared));
+        CHECK(minClearance(field, cleared) > minClearance(field, plain));
+    }
+}
+
+int main() {
+    testMatchesBruteForce();
+    testPolygonsInField();
+    testSmoothingKeepsCost();
+    testPlannersApplyClearanceSmoothing();
+    return checkResult();
+}
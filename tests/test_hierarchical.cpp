@@ -0,0 +1,69 @@
+#include "hierarchical.h"
+#include "planner.h"
+#include "test_check.h"
+
+// True if the coarse cell covers pixel pt
+static bool covers(const Corridor& corridor, const cv::Point& cell, const cv::Point2f& pt) {
+    return (int)(pt.x / corridor.cellPx) == cell.x && (int)(pt.y / corridor.cellPx) == cell.y;
+}
+
+static bool inCorridor(const Corridor& corridor, const cv::Point2f& pt) {
+    for (const cv::Point& cell : corridor.cells)
+        if (covers(corridor, cell, pt)) return true;
+    return false;
+}
+
+// The corridor links start and goal through the gap, coarsening only as far as the gap allows
+static void testCorridorThroughGap() {
+    OccupancyGrid grid = wallGrid();
+    HierarchicalConfig cfg;
+    cfg.dilation = 0;
+    Corridor corridor = findCorridor(grid, cv::Point(2, 2), cv::Point(22, 2), cfg);
+    CHECK(!corridor.empty());
+    // A 4-cell coarse cell around the 3-cell gap also holds wall, so the search drops to factor 2
+    CHECK(corridor.cellPx == 2 * grid.cellSize);
+    CHECK(inCorridor(corridor, cellCentre(grid, 2, 2)));
+    CHECK(inCorridor(corridor, cellCentre(grid, 2, 22)));
+    CHECK(inCorridor(corridor, cellCentre(grid, 21, 12)));
+
+    // Without global samples every sample lands in a corridor cell
+    cfg.globalRatio = 0;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 2000; ++i) CHECK(inCorridor(corridor, sampleCorridor(corridor, cfg, rng, 500)));
+}
+
+// A goal walled off from the start gives an empty corridor, and sampling falls back to the canvas
+static void testUnreachableGoal() {
+    std::vector<std::string> rows(25, std::string(25, '.'));
+    for (int r = 0; r < 25; ++r) rows[r][12] = '#';
+    OccupancyGrid grid = gridFromRows(rows, 20);
+    HierarchicalConfig cfg;
+    Corridor corridor = findCorridor(grid, cv::Point(2, 2), cv::Point(22, 2), cfg);
+    CHECK(corridor.empty());
+    std::mt19937 rng(2);
+    cv::Point2f pt = sampleCorridor(corridor, cfg, rng, 500);
+    CHECK(pt.x >= 0 && pt.x <= 500 && pt.y >= 0 && pt.y <= 500);
+}
+
+// Corridor-restricted planning still finds a collision-free path
+static void testHierarchicalPlanning() {
+    OccupancyGrid grid = wallGrid();
+    PlannerParams params;
+    params.hierarchical = true;
+    params.maxIter = 5000;
+    int corridors = 0;
+    PlannerHooks hooks;
+    hooks.onCorridor = [&](const Corridor& corridor) { corridors += !corridor.empty(); };
+    std::mt19937 rng(3);
+    PlanResult result = planRRTStar(grid, 500, cellCentre(grid, 2, 2), cellCentre(grid, 2, 22), params, rng, hooks);
+    CHECK(corridors == 1);
+    CHECK(result.found());
+    CHECK(pathFree(grid, result.path));
+}
+
+int main() {
+    testCorridorThroughGap();
+    testUnreachableGoal();
+    testHierarchicalPlanning();
+    return checkResult();
+}
@@ -0,0 +1,113 @@
+#include "map_deltas.h"
+#include "planner.h"
+#include "visibility_graph.h"
+#include "test_check.h"
+#include <thread>
+
+// After a delta, segment checks through the rectangle cover see the new obstacle and the cleared one
+static void testRectsFollowDeltas() {
+    OccupancyGrid grid = wallGrid();
+    ObstacleRects rects;
+    rects.build(grid);
+    grid.rects = &rects;
+    MapDeltaStream stream(grid);
+    stream.maintain(&rects, nullptr);
+
+    cv::Point2f a = cellCentre(grid, 5, 2), b = cellCentre(grid, 5, 10);
+    cv::Point2f across1 = cellCentre(grid, 2, 8), across2 = cellCentre(grid, 2, 16);
+    CHECK(collisionFree(grid, a, b));
+    CHECK(!collisionFree(grid, across1, across2));
+
+    CHECK(stream.publish({{5, 6, 1}, {2, 12, 0}}));
+    CHECK(stream.apply().size() == 2);
+    CHECK(grid.rects == &rects);
+    CHECK(!collisionFree(grid, a, b));
+    CHECK(collisionFree(grid, across1, across2));
+    CHECK(stream.apply().empty());
+}
+
+// Structures the stream was not told about are detached instead of left stale
+static void testUnregisteredStructuresDetached() {
+    OccupancyGrid grid = wallGrid();
+    ObstacleRects rects;
+    rects.build(grid);
+    DistanceField field;
+    field.build(grid);
+    grid.rects = &rects;
+    grid.distance = &field;
+    MapDeltaStream stream(grid);
+
+    stream.publish({{5, 5, 0}});          // Already free: nothing changes
+    stream.apply();
+    CHECK(grid.rects == &rects && grid.distance == &field);
+
+    stream.publish({{5, 6, 1}});
+    stream.apply();
+    CHECK(grid.rects == nullptr && grid.distance == nullptr);
+    CHECK(!collisionFree(grid, cellCentre(grid, 5, 2), cellCentre(grid, 5, 10)));
+}
+
+// A maintained distance field reports the new obstacle's clearance
+static void testDistanceFollowsDeltas() {
+    OccupancyGrid grid = wallGrid();
+    DistanceField field;
+    field.build(grid);
+    grid.distance = &field;
+    MapDeltaStream stream(grid);
+    stream.maintain(nullptr, &field);
+
+    cv::Point2f probe = cellCentre(grid, 5, 4);
+    float before = field.at(probe);
+    stream.publish({{5, 5, 1}});
+    stream.apply();
+    CHECK(grid.distance == &field);
+    CHECK(field.at(probe) < before);
+    CHECK(field.at(probe) <= grid.cellSize);
+}
+
+// The visibility graph cache is keyed by content, so a delta yields a fresh graph
+static void testVisibilityGraphAfterDelta() {
+    OccupancyGrid grid = wallGrid();
+    auto before = cachedVisibilityGraph(grid, gridVersion(grid));
+    MapDeltaStream stream(grid);
+    stream.publish({{21, 12, 1}, {20, 12, 1}, {22, 12, 1}});    // Close the gap
+    stream.apply();
+    auto after = cachedVisibilityGraph(grid, gridVersion(grid));
+    CHECK(after != before);
+    CHECK(visibilityPath(*after, grid, cellCentre(grid, 2, 2), cellCentre(grid, 2, 22)).empty());
+}
+
+// A search following the stream never returns a path through cells blocked mid-run
+static void testSearchFollowingDeltas() {
+    OccupancyGrid grid = wallGrid();
+    ObstacleRects rects;
+    rects.build(grid);
+    grid.rects = &rects;
+    MapDeltaStream stream(grid);
+    stream.maintain(&rects, nullptr);
+
+    PlannerParams params;
+    params.maxIter = 4000;
+    params.anytime = true;
+    std::mt19937 rng(4);
+    RRTStarSearch search(grid, 500, cellCentre(grid, 2, 2), cellCentre(grid, 2, 22), params, rng);
+    search.followDeltas(&stream);
+    search.step(2000);
+    std::vector<CellDelta> block;
+    for (int c = 0; c < 25; ++c)
+        if (c != 3) block.push_back({10, c, 1});
+    stream.publish(block);
+    while (search.step(100)) {}
+    PlanResult result = search.finish();
+    CHECK(pathFree(grid, result.path));
+    CHECK(pathFree(grid, result.smoothed));
+}
+
+int main() {
+    testRectsFollowDeltas();
+    testUnregisteredStructuresDetached();
+    testDistanceFollowsDeltas();
+    testVisibilityGraphAfterDelta();
+    testSearchFollowingDeltas();
+    return checkResult();
+}
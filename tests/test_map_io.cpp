@@ -0,0 +1,62 @@
+#include "map_io.h"
+#include "test_check.h"
+#include <filesystem>
+#include <fstream>
+
+static std::string mapPath() {
+    return (std::filesystem::temp_directory_path() / "rrt_map_io_test.map").string();
+}
+
+static void writeText(const std::string& text) {
+    std::ofstream(mapPath()) << text;
+}
+
+// Obstacles, costs, polygons and endpoints survive a save and load
+static void testRoundTrip() {
+    MapFile map;
+    map.gridSize = 4;
+    map.obstacles = {{0, 1}, {3, 3}};
+    map.start = cv::Point(0, 0);
+    map.goal = cv::Point(2, 3);
+    map.polygons.push_back({{1, 1}, {2.5f, 1}, {2, 2}});
+    map.costLevels.assign(16, 0);
+    map.costLevels[2 * 4 + 1] = 48;
+    CHECK(saveMap(mapPath(), map));
+
+    MapFile loaded;
+    CHECK(loadMap(mapPath(), loaded, 500));
+    CHECK(loaded.gridSize == 4 && loaded.obstacles == map.obstacles);
+    CHECK(loaded.start == map.start && loaded.goal == map.goal);
+    CHECK(loaded.polygons.size() == 1 && loaded.polygons[0] == map.polygons[0]);
+    CHECK(loaded.costLevels == map.costLevels);
+}
+
+// Sizes the canvas cannot hold and endpoints off the grid are rejected
+static void testRejectsMalformedMaps() {
+    MapFile map;
+    writeText("size 3\n...\n...\n");
+    CHECK(!loadMap(mapPath(), map, 500));           // Missing a row
+    writeText("size 0\n");
+    CHECK(!loadMap(mapPath(), map, 500));
+
+    std::string big = "size 600\n";
+    for (int r = 0; r < 600; ++r) big += std::string(600, '.') + "\n";
+    writeText(big);
+    CHECK(!loadMap(mapPath(), map, 500));
+    CHECK(loadMap(mapPath(), map, 600));
+
+    writeText("size 3\nstart 0 3\n...\n...\n...\n");
+    CHECK(!loadMap(mapPath(), map, 500));
+    writeText("size 3\ngoal -2 1\n...\n...\n...\n");
+    CHECK(!loadMap(mapPath(), map, 500));
+    writeText("size 3\nstart 2 2\ngoal 0 1\n...\n...\n...\n");
+    CHECK(loadMap(mapPath(), map, 500));
+    CHECK(map.start == cv::Point(2, 2) && map.goal == cv::Point(0, 1));
+}
+
+int main() {
+    testRoundTrip();
+    testRejectsMalformedMaps();
+    std::filesystem::remove(mapPath());
+    return checkResult();
+}
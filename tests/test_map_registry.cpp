@@ -0,0 +1,72 @@
+#include "map_registry.h"
+#include "map_io.h"
+#include "test_check.h"
+#include <filesystem>
+
+static std::string writeMaps() {
+    std::string dir = (std::filesystem::temp_directory_path() / "rrt_registry_test").string();
+    std::filesystem::create_directories(dir);
+    for (const char* id : {"a", "b", "c"}) {
+        MapFile map;
+        map.gridSize = 25;
+        map.obstacles = {{3, 4}, {5, 6}};
+        map.start = cv::Point(1, 1);
+        if (id[0] == 'c') map.polygons.push_back({{10, 10}, {14, 10}, {12, 14}});
+        saveMap(dir + "/" + id + ".map", map);
+    }
+    return dir;
+}
+
+// Hits return the cached snapshot; invalidate forces a reload with a new version
+static void testHitsAndReload() {
+    MapRegistry registry(writeMaps(), 1 << 24, 500);
+    auto first = registry.acquire("a");
+    CHECK(first != nullptr);
+    CHECK(registry.acquire("a") == first);
+    CHECK(registry.hits() == 1 && registry.misses() == 1);
+    CHECK(first->grid.occupied(3, 4) && !first->grid.occupied(4, 4));
+    CHECK(first->start == cv::Point(1, 1));
+
+    registry.invalidate("a");
+    auto second = registry.acquire("a");
+    CHECK(second != first);
+    CHECK(second->version > first->version);
+    CHECK(first->grid.occupied(3, 4));     // The old snapshot stays usable
+    CHECK(registry.acquire("missing") == nullptr);
+}
+
+// Over the cap, unreferenced maps are evicted and held ones are kept
+static void testEvictionSparesHeldMaps() {
+    MapRegistry registry(writeMaps(), 1, 500);
+    auto held = registry.acquire("a");
+    registry.acquire("b");
+    registry.acquire("c");
+    CHECK(registry.evictions() >= 1);
+    CHECK(registry.acquire("a") == held);
+    CHECK(held->grid.occupied(5, 6));
+}
+
+// Polygons in the map file block the snapshot's grid
+static void testPolygonsAttached() {
+    MapRegistry registry(writeMaps(), 1 << 24, 500);
+    auto map = registry.acquire("c");
+    CHECK(map->grid.polygons != nullptr);
+    CHECK(!collisionFree(map->grid, cv::Point2f(150, 230), cv::Point2f(350, 230)));
+}
+
+// Overlay storage counts against the cap along with the cells
+static void testOverlaysCharged() {
+    MapRegistry registry(writeMaps(), 1 << 24, 500);
+    auto plain = registry.acquire("a"), withPolygon = registry.acquire("c");
+    CHECK(withPolygon->overlays.bytes() > 0);
+    CHECK(withPolygon->bytes == plain->bytes + withPolygon->overlays.bytes());
+    CHECK(registry.residentBytes() == plain->bytes + withPolygon->bytes);
+}
+
+int main() {
+    testHitsAndReload();
+    testEvictionSparesHeldMaps();
+    testPolygonsAttached();
+    testOverlaysCharged();
+    return checkResult();
+}
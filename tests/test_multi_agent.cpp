@@ -0,0 +1,107 @@
+#include "cost_map.h"
+#include "multi_agent.h"
+#include "test_check.h"
+#include <cmath>
+
+// Cell an agent occupies at time t, moving along path at speed and parked at its end
+static int cellAt(const OccupancyGrid& grid, const std::vector<cv::Point2f>& path, float speed, float t) {
+    cv::Point2f pt = path.back();
+    float s = t * speed;
+    for (size_t i = 1; i < path.size(); ++i) {
+        float len = cv::norm(path[i] - path[i - 1]);
+        if (s <= len) {
+            pt = path[i - 1] + (path[i] - path[i - 1]) * (len > 0 ? s / len : 0.0f);
+            break;
+        }
+        s -= len;
+    }
+    return (int)(pt.y / grid.cellSize) * grid.cols + (int)(pt.x / grid.cellSize);
+}
+
+// An agent crawling through a cell blocks it for every step it spends there
+static void testReservationCoversDwellTime() {
+    OccupancyGrid grid = gridFromRows(std::vector<std::string>(5, "....."), 100);
+    ReservationConfig cfg;
+    cfg.timeMargin = 0;
+    ReservationTable table(grid, cfg);
+    table.reserve({cv::Point2f(50, 250), cv::Point2f(450, 250)}, 0);   // In cell (2, 2) during t = 30..50
+
+    for (int t = 30; t < 50; ++t)
+        CHECK(!table.segmentFree(cv::Point2f(250, 220), (float)t, cv::Point2f(250, 230), t + 0.5f));
+    CHECK(table.segmentFree(cv::Point2f(250, 150), 60, cv::Point2f(250, 160), 61));
+
+    // Parked at the end from t = 80 on
+    CHECK(!table.segmentFree(cv::Point2f(420, 220), 200, cv::Point2f(430, 230), 201));
+}
+
+// Crossing agents are planned so they never share a cell at the same time
+static void testPlannedAgentsDoNotCollide() {
+    OccupancyGrid grid = wallGrid();
+    std::vector<AgentTask> tasks = {
+        {cellCentre(grid, 21, 2), cellCentre(grid, 21, 22)},
+        {cellCentre(grid, 5, 18), cellCentre(grid, 24, 18)},
+        {cellCentre(grid, 24, 20), cellCentre(grid, 2, 20)},
+    };
+    PlannerParams params;
+    params.maxIter = 5000;
+    ReservationConfig cfg;
+    auto plans = planMultiAgent(grid, 500, tasks, params, cfg, 7);
+
+    CHECK(plans.size() == tasks.size());
+    CHECK(plans[0].found);
+    float horizon = 0;
+    for (auto& plan : plans) {
+        CHECK(pathFree(grid, plan.path));
+        float len = 0;
+        for (size_t i = 1; i < plan.path.size(); ++i) len += cv::norm(plan.path[i] - plan.path[i - 1]);
+        horizon = std::max(horizon, len / cfg.speed);
+    }
+    for (float t = 0; t <= horizon + 1; t += 0.25f)
+        for (size_t a = 0; a < plans.size(); ++a)
+            for (size_t b = a + 1; b < plans.size(); ++b)
+                if (plans[a].found && plans[b].found)
+                    CHECK(cellAt(grid, plans[a].path, cfg.speed, t) != cellAt(grid, plans[b].path, cfg.speed, t));
+}
+
+// Under a cost map the timing hook still sees path lengths, not costs
+static void testTimingIgnoresCostMap() {
+    OccupancyGrid grid = wallGrid();
+    std::vector<uint8_t> levels(grid.rows * grid.cols, 0);
+    for (int r = 0; r < grid.rows; ++r)
+        for (int c = 0; c < 12; ++c) levels[r * grid.cols + c] = 200;
+    CostMap costs;
+    costs.build(grid.rows, grid.cols, grid.cellSize, levels);
+    grid.costs = &costs;
+
+    PlannerHooks hooks;
+    int calls = 0, mismatches = 0;
+    hooks.edgeValid = [&](const cv::Point2f& from, float fromLength, const cv::Point2f& to, float toLength) {
+        ++calls;
+        mismatches += std::abs(toLength - fromLength - (float)cv::norm(to - from)) > 1e-3f * (1 + toLength);
+        return true;
+    };
+    PlannerParams params;
+    params.maxIter = 3000;
+    params.anytime = true;
+    std::mt19937 rng(2);
+    PlanResult result = planRRTStar(grid, 500, cellCentre(grid, 2, 2), cellCentre(grid, 2, 22), params, rng, hooks);
+    CHECK(result.found());
+    CHECK(calls > 0 && mismatches == 0);
+
+    std::vector<AgentTask> tasks = {
+        {cellCentre(grid, 21, 2), cellCentre(grid, 21, 22)},
+        {cellCentre(grid, 24, 8), cellCentre(grid, 14, 8)},
+    };
+    ReservationConfig cfg;
+    auto plans = planMultiAgent(grid, 500, tasks, params, cfg, 3);
+    for (float t = 0; t <= 200; t += 0.25f)
+        if (plans[0].found && plans[1].found)
+            CHECK(cellAt(grid, plans[0].path, cfg.speed, t) != cellAt(grid, plans[1].path, cfg.speed, t));
+}
+
+int main() {
+    testReservationCoversDwellTime();
+    testPlannedAgentsDoNotCollide();
+    testTimingIgnoresCostMap();
+    return checkResult();
+}
@@ -0,0 +1,55 @@
+#include "planner.h"
+#include "test_check.h"
+
+static int liveNodes(const std::vector<Node>& tree) {
+    int live = 0;
+    for (const Node& node : tree) live += node.parent != EVICTED;
+    return live;
+}
+
+// The tree never holds more than the budget, and what is left is a valid tree
+static void testBudgetHolds() {
+    OccupancyGrid grid = wallGrid();
+    PlannerParams params;
+    params.maxIter = 6000;
+    params.anytime = true;
+    params.nodeBudget = 300;
+    int peak = 0;
+    PlannerHooks hooks;
+    std::mt19937 rng(9);
+    cv::Point2f start = cellCentre(grid, 2, 2), goal = cellCentre(grid, 2, 22);
+    RRTStarSearch search(grid, 500, start, goal, params, rng, hooks);
+    while (search.step(50)) peak = std::max(peak, liveNodes(search.partial().tree));
+    PlanResult result = search.finish();
+
+    CHECK(peak <= params.nodeBudget);
+    CHECK(result.tree.size() <= (size_t)params.nodeBudget);
+    CHECK(result.found());
+    CHECK(pathFree(grid, result.path));
+    for (size_t i = 1; i < result.tree.size(); ++i) {
+        int parent = result.tree[i].parent;
+        if (parent == EVICTED) continue;
+        CHECK(parent >= 0 && result.tree[parent].parent != EVICTED);
+        CHECK(result.tree[i].cost >= result.tree[parent].cost);
+    }
+    // The best path is never evicted
+    for (int cur = result.goalIdx; cur > 0; cur = result.tree[cur].parent) CHECK(result.tree[cur].parent != EVICTED);
+}
+
+// The smallest budget keeps the root and one node without failing
+static void testTinyBudget() {
+    OccupancyGrid grid = wallGrid();
+    PlannerParams params;
+    params.maxIter = 500;
+    params.nodeBudget = 2;
+    std::mt19937 rng(10);
+    PlanResult result = planRRTStar(grid, 500, cellCentre(grid, 2, 2), cellCentre(grid, 2, 22), params, rng);
+    CHECK(liveNodes(result.tree) <= 2);
+    CHECK(result.tree[0].parent == -1);
+}
+
+int main() {
+    testBudgetHolds();
+    testTinyBudget();
+    return checkResult();
+}
@@ -0,0 +1,67 @@
+#include "obstacle_rects.h"
+#include "occupancy_grid.h"
+#include "test_check.h"
+#include <random>
+
+static OccupancyGrid randomGrid(uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<std::string> rows(25, std::string(25, '.'));
+    for (int i = 0; i < 30; ++i) {
+        int r = rng() % 25, c = rng() % 25, h = 1 + rng() % 4, w = 1 + rng() % 4;
+        for (int dr = 0; dr < h && r + dr < 25; ++dr)
+            for (int dc = 0; dc < w && c + dc < 25; ++dc) rows[r + dr][c + dc] = '#';
+    }
+    return gridFromRows(rows, 20);
+}
+
+// The rectangles cover exactly the occupied cells, with fewer rectangles than cells
+static void testCoverIsExact() {
+    for (uint32_t seed = 1; seed <= 5; ++seed) {
+        OccupancyGrid grid = randomGrid(seed);
+        ObstacleRects rects;
+        rects.build(grid);
+        int occupied = 0;
+        for (int r = 0; r < grid.rows; ++r)
+            for (int c = 0; c < grid.cols; ++c) {
+                cv::Point2f centre = cellCentre(grid, r, c);
+                bool covered = false;
+                for (const auto& rect : rects.rects())
+                    covered |= centre.x > rect.x0 && centre.x < rect.x1 && centre.y > rect.y0 && centre.y < rect.y1;
+                CHECK(covered == grid.occupied(r, c));
+                occupied += grid.occupied(r, c);
+            }
+        CHECK(rects.rects().size() < (size_t)occupied);
+    }
+}
+
+// Segment tests agree with walking every cell the segment crosses
+static void testSegmentsMatchCellWalk() {
+    std::mt19937 rng(21);
+    std::uniform_real_distribution<float> coord(0.5f, 499.5f);
+    for (uint32_t seed = 1; seed <= 5; ++seed) {
+        OccupancyGrid grid = randomGrid(seed);
+        ObstacleRects rects;
+        rects.build(grid, 4);
+        OccupancyGrid exact = grid;
+        exact.rects = &rects;
+        int blocked = 0;
+        for (int i = 0; i < 5000; ++i) {
+            cv::Point2f a(coord(rng), coord(rng)), b(coord(rng), coord(rng));
+            bool expected = !traverseCells(grid.cellSize, a, b, [&](int r, int c, float, float) {
+                return !grid.occupied(r, c);
+            });
+            CHECK(rects.intersects(a, b) == expected);
+            blocked += expected;
+
+            // With the cover attached, collisionFree is exact
+            CHECK(collisionFree(exact, a, b) == !expected);
+        }
+        CHECK(blocked > 0);
+    }
+}
+
+int main() {
+    testCoverIsExact();
+    testSegmentsMatchCellWalk();
+    return checkResult();
+}
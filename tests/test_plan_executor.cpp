@@ -0,0 +1,69 @@
+#include "plan_executor.h"
+#include "counter_rng.h"
+#include "test_check.h"
+
+// Running a search in slices gives the same result as running it in one call
+static void testSlicedSearchMatchesPlanRRTStar() {
+    OccupancyGrid grid = wallGrid();
+    PlannerParams params;
+    params.maxIter = 3000;
+    cv::Point2f start = cellCentre(grid, 2, 2), goal = cellCentre(grid, 22, 22);
+
+    std::mt19937 rngA(5), rngB(5);
+    PlanResult whole = planRRTStar(grid, 500, start, goal, params, rngA);
+    RRTStarSearch search(grid, 500, start, goal, params, rngB);
+    while (search.step(37)) {}
+    PlanResult sliced = search.finish();
+    CHECK(whole.found() && sliced.found());
+    CHECK(whole.path == sliced.path);
+    CHECK(whole.smoothed == sliced.smoothed);
+}
+
+// Tasks interleave, report improvements, and each matches a one-shot run on its stream
+static void testInterleavedTasks() {
+    OccupancyGrid grid = wallGrid();
+    PlannerParams params;
+    params.maxIter = 2000;
+    params.anytime = true;
+    cv::Point2f start = cellCentre(grid, 2, 2), goal = cellCentre(grid, 22, 22);
+
+    PlanExecutor executor(50);
+    int improvements = 0, done = 0;
+    auto onImproved = [&](const PlanProgress& progress) {
+        CHECK(progress.path.front() == start);
+        ++improvements;
+    };
+    auto a = executor.submit(grid, 500, start, goal, params, 11, onImproved, [&](const PlanResult&) { ++done; });
+    auto b = executor.submit(grid, 500, start, goal, params, 11, onImproved, [&](const PlanResult&) { ++done; });
+    CHECK(executor.pending() == 2);
+    executor.poll();
+    CHECK(!a->ready() && !b->ready());
+    while (executor.poll()) {}
+    CHECK(a->ready() && b->ready() && done == 2);
+    CHECK(improvements >= 2);
+
+    std::mt19937 rng = streamEngine(11, a->id());
+    PlanResult expected = planRRTStar(grid, 500, start, goal, params, rng);
+    CHECK(a->result().get().path == expected.path);
+}
+
+// A cancelled task finishes on the next poll and reports it stopped
+static void testCancel() {
+    OccupancyGrid grid = wallGrid();
+    PlannerParams params;
+    params.maxIter = 1000000;
+    PlanExecutor executor(10);
+    auto task = executor.submit(grid, 500, cellCentre(grid, 2, 2), cellCentre(grid, 22, 22), params, 1);
+    executor.poll();
+    task->cancel();
+    executor.poll();
+    CHECK(executor.pending() == 0);
+    CHECK(task->ready() && task->result().get().stopped);
+}
+
+int main() {
+    testSlicedSearchMatchesPlanRRTStar();
+    testInterleavedTasks();
+    testCancel();
+    return checkResult();
+}
@@ -0,0 +1,106 @@
+#include "polygon_bvh.h"
+#include "occupancy_grid.h"
+#include "test_check.h"
+#include <algorithm>
+#include <random>
+
+// Star-shaped (often concave) polygon around centre
+static Polygon starPolygon(std::mt19937& rng, const cv::Point2f& centre) {
+    std::uniform_real_distribution<float> radius(5, 30);
+    int n = 3 + rng() % 6;
+    Polygon poly;
+    for (int k = 0; k < n; ++k) {
+        float angle = 6.2831853f * k / n;
+        float r = radius(rng);
+        poly.push_back(centre + cv::Point2f(r * std::cos(angle), r * std::sin(angle)));
+    }
+    return poly;
+}
+
+static float cross(const cv::Point2f& a, const cv::Point2f& b) { return a.x * b.y - a.y * b.x; }
+
+static float pointSegmentDistance(const cv::Point2f& p, const cv::Point2f& a, const cv::Point2f& b) {
+    cv::Point2f ab = b - a;
+    float t = std::clamp((p - a).dot(ab) / std::max(ab.dot(ab), 1e-12f), 0.0f, 1.0f);
+    return (float)cv::norm(p - (a + ab * t));
+}
+
+static bool segmentsCross(const cv::Point2f& a, const cv::Point2f& b, const cv::Point2f& c, const cv::Point2f& d) {
+    float d1 = cross(b - a, c - a), d2 = cross(b - a, d - a), d3 = cross(d - c, a - c), d4 = cross(d - c, b - c);
+    return ((d1 > 0) != (d2 > 0)) && ((d3 > 0) != (d4 > 0));
+}
+
+static bool insideBrute(const Polygon& poly, const cv::Point2f& p) {
+    bool in = false;
+    for (size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++)
+        if ((poly[i].y > p.y) != (poly[j].y > p.y) &&
+            p.x < poly[j].x + (p.y - poly[j].y) * (poly[i].x - poly[j].x) / (poly[i].y - poly[j].y))
+            in = !in;
+    return in;
+}
+
+// Smallest distance between segment a-b and any polygon edge, to skip grazing cases
+static float boundaryDistance(const std::vector<Polygon>& polys, const cv::Point2f& a, const cv::Point2f& b) {
+    float best = 1e9f;
+    for (const Polygon& poly : polys)
+        for (size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++) {
+            if (segmentsCross(a, b, poly[j], poly[i])) return 0;
+            best = std::min({best, pointSegmentDistance(a, poly[j], poly[i]), pointSegmentDistance(b, poly[j], poly[i]),
+                             pointSegmentDistance(poly[i], a, b)});
+        }
+    return best;
+}
+
+// Point and segment queries agree with a scan over every polygon
+static void testMatchesBruteForce() {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> coord(0, 500);
+    std::vector<Polygon> polys;
+    for (int i = 0; i < 60; ++i) polys.push_back(starPolygon(rng, cv::Point2f(coord(rng), coord(rng))));
+    PolygonBVH bvh;
+    bvh.build(polys);
+    CHECK(bvh.polygons().size() == polys.size());
+
+    int hits = 0, checked = 0;
+    for (int i = 0; i < 20000; ++i) {
+        cv::Point2f p(coord(rng), coord(rng));
+        if (boundaryDistance(polys, p, p) < 1e-2f) continue;
+        bool expected = false;
+        for (const Polygon& poly : polys) expected |= insideBrute(poly, p);
+        CHECK(bvh.contains(p) == expected);
+        hits += expected;
+    }
+    CHECK(hits > 0);
+
+    std::uniform_real_distribution<float> offset(-60, 60);
+    for (int i = 0; i < 20000; ++i) {
+        cv::Point2f a(coord(rng), coord(rng)), b = a + cv::Point2f(offset(rng), offset(rng));
+        float gap = boundaryDistance(polys, a, b);
+        if (gap > 0 && gap < 1e-2f) continue;
+        bool expected = gap == 0;
+        for (const Polygon& poly : polys) expected |= insideBrute(poly, a);
+        CHECK(bvh.intersects(a, b) == expected);
+        checked += expected;
+    }
+    CHECK(checked > 0);
+}
+
+// Polygons on a grid block segments the cells alone would allow
+static void testGridPolygons() {
+    OccupancyGrid grid = gridFromRows(std::vector<std::string>(25, std::string(25, '.')), 20);
+    PolygonBVH bvh;
+    bvh.build({{{200, 100}, {300, 100}, {250, 400}}});
+    cv::Point2f left(100, 200), right(400, 200), below(100, 450), belowRight(400, 450);
+    CHECK(collisionFree(grid, left, right));
+    grid.polygons = &bvh;
+    CHECK(!collisionFree(grid, left, right));
+    CHECK(collisionFree(grid, below, belowRight));
+    CHECK(isObstacle(grid, cv::Point2f(250, 200)));
+    CHECK(!isObstacle(grid, cv::Point2f(210, 390)));
+}
+
+int main() {
+    testMatchesBruteForce();
+    testGridPolygons();
+    return checkResult();
+}
@@ -0,0 +1,71 @@
+#include "profile.h"
+#include "test_check.h"
+#include <filesystem>
+#include <fstream>
+
+static std::string profilePath() {
+    return (std::filesystem::temp_directory_path() / "rrt_profile_test.txt").string();
+}
+
+// Every tunable written by saveProfile() reads back unchanged
+static void testRoundTrip() {
+    PlannerParams params;
+    params.stepSize = 37.5f;
+    params.goalBiasPeriod = 7;
+    params.maxIter = 1234;
+    params.radiusScale = 61.25f;
+    params.anytime = true;
+    params.nodeBudget = 900;
+    params.turningRadius = 33.5f;
+    params.hierarchical = true;
+    params.hier.coarseFactor = 8;
+    params.hier.dilation = 2;
+    params.hier.globalRatio = 0.25f;
+    params.narrowPassage = true;
+    params.sampler.bridgeRatio = 0.4f;
+    params.sampler.gaussianRatio = 0.15f;
+    params.sampler.sigma = 12.5f;
+    params.clearanceSmoothing = true;
+    params.clearance.clearance = 30;
+    params.clearance.iterations = 25;
+    CHECK(saveProfile(profilePath(), params, "tuned on test maps\nsecond line"));
+
+    PlannerParams loaded;
+    CHECK(loadProfile(profilePath(), loaded));
+    CHECK(loaded.stepSize == params.stepSize && loaded.goalBiasPeriod == params.goalBiasPeriod);
+    CHECK(loaded.maxIter == params.maxIter && loaded.radiusScale == params.radiusScale);
+    CHECK(loaded.anytime && loaded.nodeBudget == params.nodeBudget);
+    CHECK(loaded.steering == SteeringMode::Straight && loaded.turningRadius == params.turningRadius);
+    CHECK(!loaded.compactTree && loaded.hierarchical);
+    CHECK(loaded.hier.coarseFactor == 8 && loaded.hier.dilation == 2 && loaded.hier.globalRatio == 0.25f);
+    CHECK(loaded.narrowPassage && loaded.sampler.bridgeRatio == 0.4f);
+    CHECK(loaded.sampler.gaussianRatio == 0.15f && loaded.sampler.sigma == 12.5f);
+    CHECK(loaded.clearanceSmoothing && loaded.clearance.clearance == 30 && loaded.clearance.iterations == 25);
+}
+
+// Missing keys keep their values; invalid or conflicting settings are dropped
+static void testValidation() {
+    std::ofstream(profilePath()) << "# comment\nmaxIter = 50\ngoalBiasPeriod = 0\nnodeBudget = 1\n";
+    PlannerParams params;
+    params.stepSize = 12;
+    params.nodeBudget = 40;
+    CHECK(loadProfile(profilePath(), params));
+    CHECK(params.maxIter == 50 && params.stepSize == 12);
+    CHECK(params.goalBiasPeriod == 1);
+    CHECK(params.nodeBudget == 40);
+
+    std::ofstream(profilePath()) << "compactTree = 1\nnodeBudget = 100\nsteering = 1\nclearanceSmoothing = 1\n";
+    params = PlannerParams();
+    CHECK(loadProfile(profilePath(), params));
+    CHECK(params.compactTree && params.nodeBudget == 0);
+    CHECK(params.steering == SteeringMode::Dubins && !params.clearanceSmoothing);
+
+    CHECK(!loadProfile(profilePath() + ".missing", params));
+}
+
+int main() {
+    testRoundTrip();
+    testValidation();
+    std::filesystem::remove(profilePath());
+    return checkResult();
+}
@@ -0,0 +1,55 @@
+#include "realtime.h"
+#include "test_check.h"
+
+// Finds a collision-free path through the gap within its fixed capacity
+static void testFindsPathWithinCapacity() {
+    OccupancyGrid grid = wallGrid();
+    PlannerParams params;
+    const int capacity = 3000;
+    RealTimePlanner planner(grid, 500, params, capacity);
+    cv::Point2f start = cellCentre(grid, 21, 2), goal = cellCentre(grid, 21, 22);
+    planner.reset(start, goal, 3);
+
+    int iterations = 0;
+    while (!planner.found() && iterations < 50000) {
+        int ran = planner.step(100);
+        CHECK(ran <= 100);
+        if (ran == 0) break;
+        iterations += ran;
+    }
+    CHECK(planner.found());
+    CHECK(planner.size() <= capacity);
+
+    std::vector<cv::Point2f> path(capacity);
+    int n = planner.pathInto(path.data(), capacity);
+    path.resize(n);
+    CHECK(n >= 2);
+    if (n >= 2) {
+        CHECK(path.front() == start);
+        CHECK(cv::norm(path.back() - goal) < grid.cellSize);
+        CHECK(pathFree(grid, path));
+        float len = 0;
+        for (int i = 1; i < n; ++i) len += cv::norm(path[i] - path[i - 1]);
+        CHECK(planner.bestCost() <= len + 1e-2f);
+    }
+}
+
+// reset() starts over with the same buffers, and a seed fixes the run
+static void testResetIsDeterministic() {
+    OccupancyGrid grid = wallGrid();
+    PlannerParams params;
+    RealTimePlanner planner(grid, 500, params, 2000);
+    float costs[2];
+    for (float& cost : costs) {
+        planner.reset(cellCentre(grid, 2, 2), cellCentre(grid, 22, 22), 17);
+        planner.step(1500);
+        cost = planner.found() ? planner.bestCost() : -1;
+    }
+    CHECK(costs[0] == costs[1]);
+}
+
+int main() {
+    testFindsPathWithinCapacity();
+    testResetIsDeterministic();
+    return checkResult();
+}
@@ -0,0 +1,46 @@
+#include "result_ring.h"
+#include "test_check.h"
+#include <unistd.h>
+
+// Messages read back in order; once overwritten, an old message is no longer returned
+static void testPublishAndOverwrite() {
+    std::string name = "/rrt_result_test_" + std::to_string(getpid());
+    ResultRingWriter writer;
+    CHECK(writer.create(name));
+    ResultRingReader reader;
+    CHECK(reader.open(name));
+    CHECK(reader.published() == 0);
+    CHECK(reader.peek(0) == nullptr);
+
+    std::vector<cv::Point2f> path = {{1, 2}, {3, 4}, {5, 6}};
+    CHECK(writer.publish(9, false, 12.5f, path) == 0);
+    auto hook = writer.progressHook(9);
+    hook(path, 10.f);
+    writer.publish(9, true, 10.f, path);
+    CHECK(reader.published() == 3);
+
+    const ResultSlot* slot = reader.peek(2);
+    CHECK(slot != nullptr);
+    if (slot) {
+        CHECK(slot->queryId == 9 && slot->isFinal == 1 && slot->status == ResultStatus::Found && slot->cost == 10.f);
+        CHECK(slot->numPoints == 3 && slot->points[2][0] == 5 && slot->points[2][1] == 6);
+        CHECK(reader.intact(slot, 2));
+    }
+    slot = reader.peek(1);
+    CHECK(slot && slot->isFinal == 0 && slot->status == ResultStatus::Found && slot->cost == 10.f);
+
+    // A final message without a path says why
+    CHECK(writer.publish(11, true, 0.f, {}, ResultStatus::NotFound) == 3);
+    const ResultSlot* missing = reader.peek(3);
+    CHECK(missing && missing->isFinal == 1 && missing->status == ResultStatus::NotFound && missing->numPoints == 0);
+
+    for (int i = 0; i < RESULT_SLOTS; ++i) writer.publish(10, false, 1.f, path);
+    CHECK(reader.peek(1) == nullptr && reader.peek(3) == nullptr);
+    CHECK(reader.peek(1 + RESULT_SLOTS) != nullptr);
+    CHECK(slot && !reader.intact(slot, 1));
+}
+
+int main() {
+    testPublishAndOverwrite();
+    return checkResult();
+}
@@ -0,0 +1,34 @@
+#include "revalidate.h"
+#include "test_check.h"
+
+// Reports the first segment a new obstacle blocks, for any thread count
+static void testFindsFirstBlockedSegment() {
+    OccupancyGrid grid = gridFromRows({
+        ".....",
+        ".....",
+        ".....",
+        ".....",
+        ".....",
+    }, 100);
+    std::vector<std::vector<cv::Point2f>> paths = {
+        {{50, 50}, {450, 50}, {450, 450}},
+        {{50, 450}, {250, 450}, {250, 250}, {50, 250}},
+        {{50, 150}, {450, 150}},
+    };
+    for (const PathStatus& status : revalidatePaths(grid, paths, 2)) CHECK(status.valid);
+
+    grid.cells[4 * grid.cols + 4] = 1;      // Blocks the second leg of path 0
+    grid.cells[3 * grid.cols + 2] = 1;      // Blocks the second leg of path 1
+    for (int threads : {1, 3}) {
+        auto status = revalidatePaths(grid, paths, threads);
+        CHECK(status.size() == 3);
+        CHECK(!status[0].valid && status[0].blockedSegment == 1);
+        CHECK(!status[1].valid && status[1].blockedSegment == 1);
+        CHECK(status[2].valid && status[2].blockedSegment == -1);
+    }
+}
+
+int main() {
+    testFindsFirstBlockedSegment();
+    return checkResult();
+}
@@ -0,0 +1,25 @@
+#include "sample_buffer.h"
+#include "test_check.h"
+
+// Samples stay in range, cover it evenly, and repeat for the same seed
+static void testSampleBuffer() {
+    SampleBuffer a(42, 10, 510), b(42, 10, 510);
+    int histogram[10] = {};
+    const int n = 100000;
+    for (int i = 0; i < n; ++i) {
+        cv::Point2f p = a.next(), q = b.next();
+        CHECK(p == q);
+        CHECK(p.x >= 10 && p.x < 510 && p.y >= 10 && p.y < 510);
+        ++histogram[std::min(9, (int)((p.x - 10) / 50))];
+    }
+    for (int count : histogram) CHECK(std::abs(count - n / 10) < n / 50);
+
+    a.reset(43, 10, 510);
+    b.reset(42, 10, 510);
+    CHECK(a.next() != b.next());
+}
+
+int main() {
+    testSampleBuffer();
+    return checkResult();
+}
@@ -0,0 +1,92 @@
+#include "samplers.h"
+#include "planner.h"
+#include "test_check.h"
+
+// Distance in pixels from pt to the nearest obstacle cell (cells off the grid included)
+static float obstacleDistance(const OccupancyGrid& grid, const cv::Point2f& pt) {
+    float best = 1e9f;
+    for (int r = -1; r <= grid.rows; ++r)
+        for (int c = -1; c <= grid.cols; ++c) {
+            if (!grid.occupied(r, c)) continue;
+            float dx = std::max({c * grid.cellSize - pt.x, 0.0f, pt.x - (c + 1) * grid.cellSize});
+            float dy = std::max({r * grid.cellSize - pt.y, 0.0f, pt.y - (r + 1) * grid.cellSize});
+            best = std::min(best, std::hypot(dx, dy));
+        }
+    return best;
+}
+
+// Wall down column 12 with a one-cell slit at row 12
+static OccupancyGrid slitGrid() {
+    std::vector<std::string> rows(25, std::string(25, '.'));
+    for (int r = 0; r < 25; ++r)
+        if (r != 12) rows[r][12] = '#';
+    return gridFromRows(rows, 20);
+}
+
+// Bridge samples are free midpoints between two obstacle points, so they sit in narrow gaps
+static void testBridgeSamples() {
+    OccupancyGrid grid = slitGrid();
+    SamplerConfig cfg;
+    std::mt19937 rng(5);
+    int found = 0;
+    for (int i = 0; i < 20000; ++i) {
+        cv::Point2f pt;
+        if (!sampleBridge(grid, cfg, rng, 500, pt)) continue;
+        ++found;
+        CHECK(!isObstacle(grid, pt));
+        CHECK(obstacleDistance(grid, pt) < 4 * grid.cellSize);
+    }
+    CHECK(found > 0);
+}
+
+// Gaussian samples are free points close to an obstacle boundary
+static void testGaussianSamples() {
+    OccupancyGrid grid = slitGrid();
+    SamplerConfig cfg;
+    std::mt19937 rng(6);
+    int found = 0;
+    for (int i = 0; i < 2000; ++i) {
+        cv::Point2f pt;
+        if (!sampleGaussian(grid, cfg, rng, 500, pt)) continue;
+        ++found;
+        CHECK(!isObstacle(grid, pt));
+        CHECK(obstacleDistance(grid, pt) < 6 * grid.cellSize);
+    }
+    CHECK(found > 1000);
+}
+
+// The mix follows the configured ratios and defers to the base sampler otherwise
+static void testMixRatios() {
+    OccupancyGrid grid = slitGrid();
+    SamplerConfig cfg;
+    cfg.bridgeRatio = 0;
+    cfg.gaussianRatio = 0;
+    std::mt19937 rng(7);
+    cv::Point2f pt;
+    for (int i = 0; i < 1000; ++i) CHECK(!sampleNarrowPassage(grid, cfg, rng, 500, pt));
+
+    cfg.gaussianRatio = 1;
+    int found = 0;
+    for (int i = 0; i < 1000; ++i) found += sampleNarrowPassage(grid, cfg, rng, 500, pt);
+    CHECK(found > 500);
+}
+
+// Planning through the slit with the samplers mixed in
+static void testNarrowPassagePlanning() {
+    OccupancyGrid grid = slitGrid();
+    PlannerParams params;
+    params.narrowPassage = true;
+    params.maxIter = 8000;
+    std::mt19937 rng(8);
+    PlanResult result = planRRTStar(grid, 500, cellCentre(grid, 12, 2), cellCentre(grid, 12, 22), params, rng);
+    CHECK(result.found());
+    CHECK(pathFree(grid, result.path));
+}
+
+int main() {
+    testBridgeSamples();
+    testGaussianSamples();
+    testMixRatios();
+    testNarrowPassagePlanning();
+    return checkResult();
+}
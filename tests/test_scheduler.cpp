@@ -0,0 +1,59 @@
+#include "scheduler.h"
+#include "test_check.h"
+#include <mutex>
+
+static PlanRequest request(uint64_t id, const OccupancyGrid& grid, int goalRow, int goalCol, int deadlineMs, bool anytime) {
+    PlanRequest r;
+    r.id = id;
+    r.start = cellCentre(grid, 2, 2);
+    r.goal = cellCentre(grid, goalRow, goalCol);
+    r.deadline = Clock::now() + std::chrono::milliseconds(deadlineMs);
+    r.anytime = anytime;
+    r.seed = (uint32_t)id;
+    return r;
+}
+
+// Anytime requests that refine until their deadline with a path in hand meet it
+static void testAnytimeRunToDeadlineIsNotMissed() {
+    OccupancyGrid grid = wallGrid();
+    PlannerParams params;
+    params.maxIter = 1000000;
+    std::mutex mutex;
+    std::vector<PlanOutcome> outcomes;
+    {
+        EdfScheduler scheduler(grid, 500, params, 4, [&](PlanOutcome&& o) {
+            std::lock_guard<std::mutex> lock(mutex);
+            outcomes.push_back(std::move(o));
+        });
+        for (uint64_t id = 0; id < 4; ++id) scheduler.submit(request(id, grid, 22, 22, 150, true));
+        scheduler.drain();
+        SchedulerStats stats = scheduler.stats();
+        CHECK(stats.completed == 4);
+        CHECK(stats.missed == 0);
+    }
+    CHECK(outcomes.size() == 4);
+    for (auto& o : outcomes) {
+        CHECK(o.found);
+        CHECK(!o.missedDeadline);
+        CHECK(pathFree(grid, o.path));
+    }
+}
+
+// A request whose goal cannot be reached misses its deadline
+static void testUnreachableGoalIsMissed() {
+    OccupancyGrid grid = wallGrid();
+    for (int c = 18; c <= 22; ++c) grid.cells[17 * 25 + c] = grid.cells[23 * 25 + c] = 1;
+    for (int r = 17; r <= 23; ++r) grid.cells[r * 25 + 18] = grid.cells[r * 25 + 22] = 1;
+    PlannerParams params;
+    params.maxIter = 1000000;
+    EdfScheduler scheduler(grid, 500, params, 1, [](PlanOutcome&& o) { CHECK(!o.found && o.missedDeadline); });
+    scheduler.submit(request(9, grid, 20, 20, 50, false));
+    scheduler.drain();
+    CHECK(scheduler.stats().missed == 1);
+}
+
+int main() {
+    testAnytimeRunToDeadlineIsNotMissed();
+    testUnreachableGoalIsMissed();
+    return checkResult();
+}
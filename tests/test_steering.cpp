@@ -0,0 +1,45 @@
+#include "steering.h"
+#include "test_check.h"
+#include <cmath>
+#include <random>
+
+// The table is used to skip candidates, so it must never exceed the exact length
+static void testTableIsLowerBound(SteeringMode mode) {
+    const float rho = 20, range = 75;
+    SteeringTable table;
+    table.build(mode, rho, range);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> pos(100, 400), offset(-range, range), heading(0, 6.2831853f);
+    int violations = 0;
+    for (int i = 0; i < 20000; ++i) {
+        Pose a = {pos(rng), pos(rng), heading(rng)};
+        Pose b = {a.x + offset(rng), a.y + offset(rng), heading(rng)};
+        float exact = shortestPath(mode, a, b, rho).length() * rho;
+        violations += table.lowerBound(a, b) > exact + 1e-3f;
+    }
+    CHECK(violations == 0);
+}
+
+// Following the returned curve ends at the goal pose
+static void testPathReachesGoal(SteeringMode mode) {
+    const float rho = 20;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> pos(-100, 100), heading(0, 6.2831853f);
+    for (int i = 0; i < 500; ++i) {
+        Pose a = {250, 250, heading(rng)};
+        Pose b = {250 + pos(rng), 250 + pos(rng), heading(rng)};
+        CurvePath path = shortestPath(mode, a, b, rho);
+        Pose end = interpolate(a, path, rho, path.length() * rho);
+        float dTheta = std::remainder(end.theta - b.theta, 6.2831853f);
+        CHECK(std::hypot(end.x - b.x, end.y - b.y) < 0.05f);
+        CHECK(std::abs(dTheta) < 1e-3f);
+    }
+}
+
+int main() {
+    for (SteeringMode mode : {SteeringMode::Dubins, SteeringMode::ReedsShepp}) {
+        testTableIsLowerBound(mode);
+        testPathReachesGoal(mode);
+    }
+    return checkResult();
+}
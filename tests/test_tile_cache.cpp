@@ -0,0 +1,93 @@
+#include "tile_cache.h"
+#include "test_check.h"
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <thread>
+
+// 130x200 cells, not a multiple of the tile size, with random blocks
+static OccupancyGrid randomGrid() {
+    OccupancyGrid grid;
+    grid.rows = 130;
+    grid.cols = 200;
+    grid.cellSize = 4;
+    grid.cells.assign(grid.rows * grid.cols, 0);
+    std::mt19937 rng(3);
+    for (int i = 0; i < 60; ++i) {
+        int r = rng() % grid.rows, c = rng() % grid.cols;
+        for (int dr = 0; dr < 6; ++dr)
+            for (int dc = 0; dc < 6; ++dc)
+                if (r + dr < grid.rows && c + dc < grid.cols) grid.cells[(r + dr) * grid.cols + c + dc] = 1;
+    }
+    return grid;
+}
+
+static std::string tiledPath() {
+    return (std::filesystem::temp_directory_path() / "rrt_tile_cache_test.til").string();
+}
+
+// Points tile `index` past the end of the file, or makes it claim more bytes than the file holds
+static void corruptTile(const std::string& path, int index, bool badOffset) {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    TileIndexEntry entry;
+    std::streamoff at = sizeof(TiledFileHeader) + index * sizeof(TileIndexEntry);
+    file.seekg(at);
+    file.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+    if (badOffset) entry.offset = 1ull << 40;
+    else entry.bytes = 0xffffffffu;
+    file.seekp(at);
+    file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+}
+
+// After a corrupt tile, both the planning thread and the prefetch thread keep reading
+static void testCorruptTileDoesNotStopReads() {
+    OccupancyGrid grid = randomGrid();
+    CHECK(writeTiledMap(tiledPath(), grid, 32));
+    corruptTile(tiledPath(), 1, true);
+    TileCache cache;
+    CHECK(cache.open(tiledPath(), 16));
+
+    cache.prefetchSegment(cv::Point2f(10, 10), cv::Point2f(790, 10), 0);
+    for (int i = 0; i < 200 && cache.prefetched() < 6; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    CHECK(cache.prefetched() == 6);
+    for (int r = 0; r < grid.rows; ++r)
+        for (int c = 0; c < grid.cols; ++c) {
+            bool corrupt = r < 32 && c >= 32 && c < 64;
+            CHECK(cache.occupied(r, c) == (corrupt || grid.occupied(r, c)));
+        }
+}
+
+// Collision checks through the cache agree with the in-memory grid, and
+// prefetched tiles are served without a synchronous read
+static void testTileCache() {
+    OccupancyGrid grid = randomGrid();
+    CHECK(writeTiledMap(tiledPath(), grid, 32));
+    TileCache cache;
+    CHECK(cache.open(tiledPath(), 6));
+    OccupancyGrid tiled = cache.grid();
+    CHECK(tiled.rows == grid.rows && tiled.cols == grid.cols);
+
+    std::mt19937 rng(8);
+    std::uniform_real_distribution<float> x(0, grid.cols * grid.cellSize), y(0, grid.rows * grid.cellSize);
+    for (int i = 0; i < 2000; ++i) {
+        cv::Point2f a(x(rng), y(rng)), b(x(rng), y(rng));
+        CHECK(collisionFree(tiled, a, b) == collisionFree(grid, a, b));
+    }
+    CHECK(cache.residentTiles() <= 6);
+
+    cache.open(tiledPath(), 16);
+    cv::Point2f a(10, 10), b(790, 10);
+    cache.prefetchSegment(a, b, 0);
+    for (int i = 0; i < 200 && cache.prefetched() < 7; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    CHECK(cache.prefetched() == 7);
+    for (int c = 0; c < grid.cols; ++c) CHECK(cache.occupied(2, c) == grid.occupied(2, c));
+    CHECK(cache.misses() == 0);
+    CHECK(cache.prefetchHits() == 7);
+}
+
+int main() {
+    testTileCache();
+    testCorruptTileDoesNotStopReads();
+    std::filesystem::remove(tiledPath());
+    return checkResult();
+}
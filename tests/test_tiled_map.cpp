@@ -0,0 +1,84 @@
+#include "tiled_map.h"
+#include "test_check.h"
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+// 130x200 cells, not a multiple of the tile size, with random blocks
+static OccupancyGrid randomGrid() {
+    OccupancyGrid grid;
+    grid.rows = 130;
+    grid.cols = 200;
+    grid.cellSize = 4;
+    grid.cells.assign(grid.rows * grid.cols, 0);
+    std::mt19937 rng(3);
+    for (int i = 0; i < 60; ++i) {
+        int r = rng() % grid.rows, c = rng() % grid.cols;
+        for (int dr = 0; dr < 6; ++dr)
+            for (int dc = 0; dc < 6; ++dc)
+                if (r + dr < grid.rows && c + dc < grid.cols) grid.cells[(r + dr) * grid.cols + c + dc] = 1;
+    }
+    return grid;
+}
+
+static std::string tiledPath() {
+    return (std::filesystem::temp_directory_path() / "rrt_tiled_test.til").string();
+}
+
+// Points tile `index` past the end of the file, or makes it claim more bytes than the file holds
+static void corruptTile(const std::string& path, int index, bool badOffset) {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    TileIndexEntry entry;
+    std::streamoff at = sizeof(TiledFileHeader) + index * sizeof(TileIndexEntry);
+    file.seekg(at);
+    file.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+    if (badOffset) entry.offset = 1ull << 40;
+    else entry.bytes = 0xffffffffu;
+    file.seekp(at);
+    file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+}
+
+// Corrupt tiles read as occupied; every other tile still reads back afterwards
+static void testCorruptTiles() {
+    OccupancyGrid grid = randomGrid();
+    CHECK(writeTiledMap(tiledPath(), grid, 32));
+    corruptTile(tiledPath(), 0, true);
+    corruptTile(tiledPath(), 8, false);
+    TiledMap map;
+    CHECK(map.open(tiledPath(), 64));
+    std::vector<uint8_t> cells;
+    CHECK(!map.readTile(0, cells));
+    CHECK(!map.readTile(8, cells));
+    for (int r = 0; r < grid.rows; ++r)
+        for (int c = 0; c < grid.cols; ++c) {
+            int tile = (r / 32) * map.tileCols() + c / 32;
+            CHECK(map.occupied(r, c) == (tile == 0 || tile == 8 || grid.occupied(r, c)));
+        }
+}
+
+// Every cell and window reads back, with at most cacheTiles resident
+static void testTiledMapRoundTrip() {
+    OccupancyGrid grid = randomGrid();
+    CHECK(writeTiledMap(tiledPath(), grid, 32));
+    TiledMap map;
+    CHECK(map.open(tiledPath(), 4));
+    CHECK(map.rows() == grid.rows && map.cols() == grid.cols && map.cellSize() == grid.cellSize);
+    CHECK(map.tileRows() == 5 && map.tileCols() == 7);
+    CHECK(map.compressedBytes() < grid.cells.size());
+    for (int r = 0; r < grid.rows; ++r)
+        for (int c = 0; c < grid.cols; ++c) CHECK(map.occupied(r, c) == grid.occupied(r, c));
+    CHECK(map.residentTiles() <= 4);
+    CHECK(map.occupied(-1, 0) && map.occupied(0, grid.cols));
+
+    OccupancyGrid window = map.window(20, 150, 40, 50);
+    CHECK(window.rows == 40 && window.cols == 50);
+    for (int r = 0; r < window.rows; ++r)
+        for (int c = 0; c < window.cols; ++c) CHECK(window.occupied(r, c) == grid.occupied(20 + r, 150 + c));
+}
+
+int main() {
+    testTiledMapRoundTrip();
+    testCorruptTiles();
+    std::filesystem::remove(tiledPath());
+    return checkResult();
+}
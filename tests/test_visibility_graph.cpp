@@ -0,0 +1,99 @@
+#include "visibility_graph.h"
+#include "test_check.h"
+
+static float length(const std::vector<cv::Point2f>& path) {
+    float total = 0;
+    for (size_t i = 1; i < path.size(); ++i) total += cv::norm(path[i] - path[i - 1]);
+    return total;
+}
+
+// The path bends around the wall's end and is no longer than the bend requires
+static void testPathAroundWall() {
+    OccupancyGrid grid = wallGrid();
+    VisibilityGraph graph;
+    graph.build(grid, gridVersion(grid), 2);
+    CHECK(!graph.corners.empty());
+    CHECK(graph.edgeStart.size() == graph.corners.size() + 1);
+    for (const cv::Point2f& corner : graph.corners) CHECK(!grid.occupiedAt(corner));
+
+    cv::Point2f start = cellCentre(grid, 2, 2), goal = cellCentre(grid, 2, 22);
+    auto path = visibilityPath(graph, grid, start, goal);
+    CHECK(path.size() >= 3);
+    if (path.size() >= 3) {
+        CHECK(path.front() == start && path.back() == goal);
+        CHECK(pathFree(grid, path));
+        // Via the gap's top corners at y = 400: two long legs and the wall's width
+        float lowerBound = 2 * std::hypot(240.f - 50, 400.f - 50);
+        CHECK(length(path) >= lowerBound);
+        CHECK(length(path) <= lowerBound + 2 * grid.cellSize);
+    }
+
+    auto direct = visibilityPath(graph, grid, cellCentre(grid, 2, 2), cellCentre(grid, 8, 2));
+    CHECK(direct.size() == 2);
+}
+
+// The cache rebuilds only when the map content changes
+static void testCacheFollowsContent() {
+    OccupancyGrid grid = wallGrid();
+    uint64_t version = gridVersion(grid);
+    auto first = cachedVisibilityGraph(grid, version);
+    CHECK(cachedVisibilityGraph(grid, gridVersion(grid)) == first);
+    grid.cells[5 * grid.cols + 5] = 1;
+    CHECK(gridVersion(grid) != version);
+    auto second = cachedVisibilityGraph(grid, gridVersion(grid));
+    CHECK(second != first && second->version == gridVersion(grid));
+}
+
+// Polygon corners are graph nodes, so a path exists around a polygon on an empty grid
+static void testPathAroundPolygon() {
+    OccupancyGrid grid = gridFromRows(std::vector<std::string>(25, std::string(25, '.')), 20);
+    PolygonBVH polygons;
+    polygons.build({{{250, 20}, {300, 400}, {200, 400}}});     // Tall triangle between start and goal
+    grid.polygons = &polygons;
+    VisibilityGraph graph;
+    graph.build(grid, gridVersion(grid), 2);
+    CHECK(graph.corners.size() == 3);
+    for (const cv::Point2f& corner : graph.corners) CHECK(!isObstacle(grid, corner));
+
+    cv::Point2f start(100, 200), goal(400, 200);
+    auto path = visibilityPath(graph, grid, start, goal);
+    CHECK(path.size() == 3);
+    if (path.size() == 3) {
+        CHECK(pathFree(grid, path));
+        // Over the apex at (250, 20), pushed a few pixels up off the sharp tip
+        float bend = 2 * std::hypot(150.f, 180.f);
+        CHECK(length(path) >= bend && length(path) <= bend + 10);
+    }
+}
+
+// Moving a polygon vertex or changing a cost level changes the version
+static void testVersionCoversOverlays() {
+    OccupancyGrid grid = wallGrid();
+    uint64_t plain = gridVersion(grid);
+    PolygonBVH first, second;
+    first.build({{{50, 50}, {80, 50}, {60, 90}}});
+    second.build({{{50, 50}, {80, 50}, {60, 91}}});
+    grid.polygons = &first;
+    uint64_t withFirst = gridVersion(grid);
+    grid.polygons = &second;
+    CHECK(withFirst != plain && gridVersion(grid) != withFirst);
+
+    grid.polygons = nullptr;
+    std::vector<uint8_t> levels(grid.rows * grid.cols, 0);
+    CostMap flat, raised;
+    flat.build(grid.rows, grid.cols, grid.cellSize, levels);
+    levels[7] = 40;
+    raised.build(grid.rows, grid.cols, grid.cellSize, levels);
+    grid.costs = &flat;
+    uint64_t withFlat = gridVersion(grid);
+    grid.costs = &raised;
+    CHECK(withFlat != plain && gridVersion(grid) != withFlat);
+}
+
+int main() {
+    testPathAroundWall();
+    testCacheFollowsContent();
+    testPathAroundPolygon();
+    testVersionCoversOverlays();
+    return checkResult();
+}
@@ -0,0 +1,61 @@
+#include "worker_pool.h"
+#include "counter_rng.h"
+#include "mapped_grid.h"
+#include "test_check.h"
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <thread>
+#include <unistd.h>
+
+// Every query is answered once, with the path an in-process run on the same stream gives
+static void testRepliesMatchInProcessPlanning() {
+    OccupancyGrid grid = wallGrid();
+    std::string path = (std::filesystem::temp_directory_path() / ("rrt_pool_" + std::to_string(getpid()) + ".occ")).string();
+    CHECK(writeOccupancyFile(path, grid));
+    PlannerParams params;
+    params.maxIter = 3000;
+
+    std::vector<PlanQuery> queries;
+    {
+        WorkerPool pool(path, 500, params, 3);
+        CHECK(pool.start());
+        for (uint64_t id = 0; id < 6; ++id) {
+            cv::Point2f start = cellCentre(grid, 2 + (int)id, 2), goal = cellCentre(grid, 22, 20);
+            queries.push_back({id, start.x, start.y, goal.x, goal.y, 21});
+            CHECK(pool.submit(queries.back()));
+        }
+
+        std::map<uint64_t, PlanReply> replies;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+        PlanReply reply;
+        while (replies.size() < queries.size() && std::chrono::steady_clock::now() < deadline) {
+            if (pool.poll(reply)) {
+                CHECK(!replies.count(reply.id));
+                replies[reply.id] = reply;
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        CHECK(replies.size() == queries.size());
+
+        for (const PlanQuery& query : queries) {
+            std::mt19937 rng = streamEngine(query.seed, query.id);
+            PlanResult expected = planRRTStar(grid, 500, cv::Point2f(query.startX, query.startY),
+                                              cv::Point2f(query.goalX, query.goalY), params, rng);
+            auto it = replies.find(query.id);
+            if (it == replies.end()) continue;
+            const PlanReply& got = it->second;
+            CHECK(got.status == (expected.found() ? ReplyStatus::Found : ReplyStatus::NotFound));
+            CHECK(got.numPoints == (int)expected.smoothed.size());
+            for (int i = 0; i < got.numPoints && i < (int)expected.smoothed.size(); ++i)
+                CHECK(got.points[i][0] == expected.smoothed[i].x && got.points[i][1] == expected.smoothed[i].y);
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+int main() {
+    testRepliesMatchInProcessPlanning();
+    return checkResult();
+}